@@ -0,0 +1,148 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/grid.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Grid creation, clone and destruction latency against process count, and
+// one-by-one against batched creation of a full grid with its row and 
+// column subgrids
+//
+// Usage: bench_grid_startup [repetitions]
+
+using hrt = std::chrono::high_resolution_clock;
+using dur = std::chrono::duration<double, std::milli>;
+
+// Slowest process' average time (ms) of op
+template <typename Op>
+double time_op( MPI_Comm comm, int64_t nrep, Op&& op ) {
+
+  double t = 0.;
+  for( int64_t rep = 0; rep < nrep; ++rep ) {
+    MPI_Barrier( comm );
+    auto st = hrt::now();
+    op();
+    t += dur( hrt::now() - st ).count();
+  }
+  t /= nrep;
+  MPI_Allreduce( MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, comm );
+  return t;
+
+}
+
+// Full grid followed by its row and column subgrids
+std::vector<blacspp::GridSpec> startup_specs( int64_t np ) {
+
+  int64_t npr = std::sqrt( np );
+  while( np % npr ) npr--;
+  const int64_t npc = np / npr;
+
+  std::vector<blacspp::GridSpec> specs;
+  specs.emplace_back( npr, npc );
+  for( int64_t pr = 0; pr < npr; ++pr ) {
+    std::vector<int64_t> map( npc );
+    for( int64_t pc = 0; pc < npc; ++pc ) map[pc] = pr*npc + pc;
+    specs.emplace_back( 1, npc, map );
+  }
+  for( int64_t pc = 0; pc < npc; ++pc ) {
+    std::vector<int64_t> map( npr );
+    for( int64_t pr = 0; pr < npr; ++pr ) map[pr] = pr*npc + pc;
+    specs.emplace_back( npr, 1, map );
+  }
+  return specs;
+
+}
+
+int main( int argc, char** argv ) {
+
+  MPI_Init( &argc, &argv );
+
+  {
+
+  const int64_t nrep = argc > 1 ? std::atoll( argv[1] ) : 10;
+
+  blacspp::mpi_info world( MPI_COMM_WORLD );
+
+  // Powers of two and the full communicator
+  std::vector<int64_t> nprocs;
+  for( int64_t np = 1; np < world.size(); np *= 2 ) nprocs.push_back( np );
+  nprocs.push_back( world.size() );
+
+  if( world.rank() == 0 )
+    std::cout << std::setw(8)  << "NPROCS" 
+              << std::setw(14) << "Create (ms)" 
+              << std::setw(14) << "Clone (ms)"
+              << std::setw(14) << "Destroy (ms)"
+              << std::setw(8)  << "Grids"
+              << std::setw(16) << "One-by-one (ms)"
+              << std::setw(14) << "Batch (ms)" << std::endl;
+
+  for( auto np : nprocs ) {
+
+    MPI_Comm comm;
+    MPI_Comm_split( MPI_COMM_WORLD, world.rank() < np ? 0 : MPI_UNDEFINED, 
+                    world.rank(), &comm );
+
+    if( comm != MPI_COMM_NULL ) {
+
+      const auto specs = startup_specs( np );
+
+      auto t_create = time_op( comm, nrep, [&]() { 
+        auto grid = blacspp::Grid::square_grid( comm ); 
+      });
+
+      auto grid = blacspp::Grid::square_grid( comm );
+      auto t_clone = time_op( comm, nrep, [&]() { auto clone = grid.clone(); } );
+
+      // Destruction alone: create outside of the timed region
+      double t_destroy = 0.;
+      for( int64_t rep = 0; rep < nrep; ++rep ) {
+        auto* tmp = new blacspp::Grid( blacspp::Grid::square_grid( comm ) );
+        MPI_Barrier( comm );
+        auto st = hrt::now();
+        delete tmp;
+        t_destroy += dur( hrt::now() - st ).count();
+      }
+      t_destroy /= nrep;
+      MPI_Allreduce( MPI_IN_PLACE, &t_destroy, 1, MPI_DOUBLE, MPI_MAX, comm );
+
+      auto t_single = time_op( comm, nrep, [&]() {
+        std::vector<blacspp::Grid> grids;
+        for( auto spec : specs )
+          grids.emplace_back( comm, spec.npr, spec.npc, spec.map.data(), 
+                              spec.npr );
+      });
+
+      auto t_batch = time_op( comm, nrep, [&]() {
+        auto grids = blacspp::Grid::batch( comm, specs );
+      });
+
+      if( world.rank() == 0 )
+        std::cout << std::setw(8)  << np 
+                  << std::setw(14) << t_create 
+                  << std::setw(14) << t_clone
+                  << std::setw(14) << t_destroy
+                  << std::setw(8)  << specs.size()
+                  << std::setw(16) << t_single
+                  << std::setw(14) << t_batch << std::endl;
+
+      MPI_Comm_free( &comm );
+
+    }
+
+  }
+
+  }
+
+  MPI_Finalize();
+
+}
@@ -0,0 +1,106 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/progress.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Communication / computation overlap with and without a ProgressEngine
+//
+// Usage: bench_progress [message doubles] [gemm dim] [repetitions]
+
+using hrt = std::chrono::high_resolution_clock;
+using dur = std::chrono::duration<double, std::milli>;
+
+// Naive local GEMM standing in for the application's compute phase
+double local_gemm( int64_t n, const std::vector<double>& A,
+  const std::vector<double>& B, std::vector<double>& C ) {
+
+  for( int64_t j = 0; j < n; ++j )
+  for( int64_t k = 0; k < n; ++k ) {
+    const auto b = B[k + j*n];
+    for( int64_t i = 0; i < n; ++i ) C[i + j*n] += A[i + k*n] * b;
+  }
+  return C[0];
+
+}
+
+int main( int argc, char** argv ) {
+
+  int provided;
+  MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+
+  {
+
+  const int64_t nmsg = argc > 1 ? std::atoll( argv[1] ) : (1 << 22);
+  const int64_t ngemm = argc > 2 ? std::atoll( argv[2] ) : 384;
+  const int64_t nrep  = argc > 3 ? std::atoll( argv[3] ) : 5;
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto npc   = grid.npc();
+  const auto right = (grid.ipc() + 1) % npc;
+  const auto left  = (grid.ipc() + npc - 1) % npc;
+
+  std::vector<double> send( nmsg, 1. ), recv( nmsg );
+  std::vector<double> A( ngemm*ngemm, 1. ), B( ngemm*ngemm, 1. ), C( ngemm*ngemm );
+
+  auto exchange = [&]() {
+    auto r = blacspp::igerv2d( grid, recv, grid.ipr(), left  );
+    auto s = blacspp::igesd2d( grid, send, grid.ipr(), right );
+    return std::make_pair( r, s );
+  };
+
+  auto time = [&]( bool comm, bool comp, blacspp::ProgressEngine* engine ) {
+    double t = 0.;
+    for( int64_t rep = 0; rep < nrep; ++rep ) {
+      MPI_Barrier( grid.comm() );
+      auto st = hrt::now();
+      std::pair<blacspp::Request,blacspp::Request> reqs;
+      if( comm ) {
+        reqs = exchange();
+        if( engine ) { engine->submit( reqs.first ); engine->submit( reqs.second ); }
+      }
+      if( comp ) local_gemm( ngemm, A, B, C );
+      reqs.first.wait(); reqs.second.wait();
+      MPI_Barrier( grid.comm() );
+      t += dur( hrt::now() - st ).count();
+    }
+    return t / nrep;
+  };
+
+  auto t_comm = time( true,  false, nullptr );
+  auto t_comp = time( false, true,  nullptr );
+  auto t_none = time( true,  true,  nullptr );
+
+  double t_prog = -1.;
+  if( provided >= MPI_THREAD_MULTIPLE ) {
+    blacspp::ProgressEngine engine;
+    t_prog = time( true, true, &engine );
+  }
+
+  if( grid.ipr() == 0 and grid.ipc() == 0 ) {
+    const double mb = nmsg * sizeof(double) / 1.e6;
+    std::cout << "Message Size (MB)            = " << mb     << std::endl;
+    std::cout << "Communication Only (ms)      = " << t_comm << std::endl;
+    std::cout << "Computation Only (ms)        = " << t_comp << std::endl;
+    std::cout << "Overlap, No Engine (ms)      = " << t_none << std::endl;
+    if( t_prog >= 0. )
+    std::cout << "Overlap, ProgressEngine (ms) = " << t_prog << std::endl;
+    else
+    std::cout << "Overlap, ProgressEngine      : MPI_THREAD_MULTIPLE unavailable" << std::endl;
+    std::cout << "Effective Bandwidth (MB/s)   = " << mb / (t_comm * 1e-3) << std::endl;
+  }
+
+  }
+
+  MPI_Finalize();
+
+}
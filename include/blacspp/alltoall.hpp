@@ -0,0 +1,362 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/reduce.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Algorithms for irregular all-to-all exchanges.
+ */
+enum class AlltoallAlgorithm {
+  Auto,     ///< Select by message size (agreed upon by all participants)
+  Pairwise, ///< P-1 rounds, one message per partner (bandwidth optimal)
+  Bruck     ///< ceil(log2 P) rounds of aggregated messages (latency optimal)
+};
+
+namespace detail {
+
+  /// Largest block (in bytes) for which AlltoallAlgorithm::Auto selects Bruck
+  constexpr int64_t alltoall_bruck_threshold = 1024;
+
+  inline std::vector<int64_t> displacements( const std::vector<int64_t>& counts ) {
+    std::vector<int64_t> displ( counts.size() + 1, 0 );
+    for( size_t p = 0; p < counts.size(); ++p ) displ[p+1] = displ[p] + counts[p];
+    return displ;
+  }
+
+  /**
+   *  \brief Pairwise exchange: in round s, send to me+s and recieve from me-s.
+   */
+  template <typename T>
+  void alltoallv_pairwise( const scope_members& members, MPI_Comm comm,
+    const int64_t* scounts, const int64_t* sdispl, const T* sbuf,
+    const int64_t* rcounts, const int64_t* rdispl, T* rbuf ) {
+
+    const auto P  = members.size();
+    const auto me = members.me;
+    const auto dtype = mpi_type<T>::type();
+    const auto tag   = internal::mpi_int(Tag::Alltoall);
+
+    std::copy_n( sbuf + sdispl[me], scounts[me], rbuf + rdispl[me] );
+    for( int64_t s = 1; s < P; ++s ) {
+      const auto dst = (me + s) % P;
+      const auto src = (me - s + P) % P;
+      MPI_Sendrecv( sbuf + sdispl[dst], scounts[dst], dtype, members.ranks[dst], tag,
+                    rbuf + rdispl[src], rcounts[src], dtype, members.ranks[src], tag,
+                    comm, MPI_STATUS_IGNORE );
+    }
+
+  }
+
+  /**
+   *  \brief Bruck exchange with variable block sizes.
+   *
+   *  Blocks are indexed by their distance k = (dest - me) mod P. In round
+   *  2^r every block whose index has bit r set is forwarded 2^r positions
+   *  ahead, so after ceil(log2 P) rounds the block at index k holds the data
+   *  sent to this process by (me - k) mod P. Block sizes travel with the
+   *  data, as intermediate processes cannot know them.
+   */
+  template <typename T>
+  void alltoallv_bruck( const scope_members& members, MPI_Comm comm,
+    const int64_t* scounts, const int64_t* sdispl, const T* sbuf,
+    const int64_t* rcounts, const int64_t* rdispl, T* rbuf ) {
+
+    const auto P  = members.size();
+    const auto me = members.me;
+    const auto tag = internal::mpi_int(Tag::Alltoall);
+
+    std::vector< std::vector<T> > blocks( P );
+    for( int64_t k = 0; k < P; ++k ) {
+      const auto dst = (me + k) % P;
+      blocks[k].assign( sbuf + sdispl[dst], sbuf + sdispl[dst] + scounts[dst] );
+    }
+
+    std::vector<char> sbytes, rbytes;
+    for( int64_t dist = 1; dist < P; dist <<= 1 ) {
+
+      // Pack [ counts | data ] of every block with the bit set
+      int64_t nblk = 0, nelem = 0;
+      for( int64_t k = dist; k < P; ++k ) if( k & dist ) {
+        ++nblk; nelem += blocks[k].size();
+      }
+
+      sbytes.resize( nblk * sizeof(int64_t) + nelem * sizeof(T) );
+      auto cnt  = reinterpret_cast<int64_t*>( sbytes.data() );
+      auto data = sbytes.data() + nblk * sizeof(int64_t);
+      for( int64_t k = dist; k < P; ++k ) if( k & dist ) {
+        *cnt++ = blocks[k].size();
+        std::memcpy( data, blocks[k].data(), blocks[k].size() * sizeof(T) );
+        data += blocks[k].size() * sizeof(T);
+      }
+
+      const auto dst = members.ranks[ (me + dist) % P ];
+      const auto src = members.ranks[ (me - dist + P) % P ];
+
+      MPI_Request sreq;
+      MPI_Isend( sbytes.data(), sbytes.size(), MPI_BYTE, dst, tag, comm, &sreq );
+
+      // Matched probe, so that the sized message is the one recieved
+      MPI_Message message;
+      MPI_Status  status;
+      internal::mpi_int nbytes;
+      MPI_Mprobe( src, tag, comm, &message, &status );
+      MPI_Get_count( &status, MPI_BYTE, &nbytes );
+      rbytes.resize( nbytes );
+      MPI_Mrecv( rbytes.data(), nbytes, MPI_BYTE, &message, MPI_STATUS_IGNORE );
+      MPI_Wait( &sreq, MPI_STATUS_IGNORE );
+
+      auto rcnt  = reinterpret_cast<const int64_t*>( rbytes.data() );
+      auto rdata = rbytes.data() + nblk * sizeof(int64_t);
+      for( int64_t k = dist; k < P; ++k ) if( k & dist ) {
+        blocks[k].resize( *rcnt++ );
+        std::memcpy( blocks[k].data(), rdata, blocks[k].size() * sizeof(T) );
+        rdata += blocks[k].size() * sizeof(T);
+      }
+
+    }
+
+    for( int64_t k = 0; k < P; ++k ) {
+      const auto src = (me - k + P) % P;
+      if( int64_t(blocks[k].size()) != rcounts[src] )
+        throw std::runtime_error("Alltoall Message Size Mismatch");
+      std::copy_n( blocks[k].data(), rcounts[src], rbuf + rdispl[src] );
+    }
+
+  }
+
+  /**
+   *  \brief Exchange the per-partner counts of an irregular all-to-all.
+   *
+   *  Piggybacks the largest block size of every participant, so that all
+   *  participants agree on AlltoallAlgorithm::Auto without an additional
+   *  collective.
+   *
+   *  @returns Recieve counts (length P) and the global maximum count
+   */
+  inline std::pair< std::vector<int64_t>, int64_t >
+    exchange_counts( const scope_members& members, MPI_Comm comm,
+                     const int64_t* send_counts ) {
+
+    const auto P = members.size();
+    const auto mx = *std::max_element( send_counts, send_counts + P );
+
+    std::vector<int64_t> sbuf( 2*P ), rbuf( 2*P );
+    for( int64_t p = 0; p < P; ++p ) {
+      sbuf[2*p] = send_counts[p]; sbuf[2*p+1] = mx;
+    }
+
+    std::vector<int64_t> c( P, 2 ), d = displacements( c );
+    alltoallv_bruck( members, comm, c.data(), d.data(), sbuf.data(),
+                     c.data(), d.data(), rbuf.data() );
+
+    std::vector<int64_t> recv_counts( P );
+    int64_t gmax = 0;
+    for( int64_t p = 0; p < P; ++p ) {
+      recv_counts[p] = rbuf[2*p];
+      gmax = std::max( gmax, rbuf[2*p+1] );
+    }
+    return { recv_counts, gmax };
+
+  }
+
+}
+
+
+/**
+ *  \brief Persistent plan for an irregular all-to-all over a grid scope.
+ *
+ *  Participant p sends send_counts[q] elements to every participant q of
+ *  the scope (ordered by grid coordinate, row-major for Scope::All), packed
+ *  contiguously in q order, and recieves recv_counts[q] elements from each q,
+ *  likewise packed in q order. Counts, displacements and the algorithm are
+ *  determined once, so repeated exchanges with the same counts (e.g. in a
+ *  fixed redistribution) pay no setup cost.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ */
+template <typename T>
+class AlltoallvPlan {
+
+  static_assert( detail::blacs_supported<T>::value, "T must be BLACS enabled" );
+
+  MPI_Comm               comm_;
+  detail::scope_members  members_;
+  std::vector<int64_t>   scounts_, sdispl_, rcounts_, rdispl_;
+  AlltoallAlgorithm      algorithm_;
+
+  void select( AlltoallAlgorithm alg, int64_t max_count ) {
+    if( alg == AlltoallAlgorithm::Auto )
+      alg = int64_t(max_count * sizeof(T)) <= detail::alltoall_bruck_threshold ?
+            AlltoallAlgorithm::Bruck : AlltoallAlgorithm::Pairwise;
+    algorithm_ = alg;
+  }
+
+public:
+
+  /**
+   *  \brief Construct a plan, exchanging counts to determine recv_counts.
+   *
+   *  @param[in] grid        (local) BLACS grid which defined the communication context.
+   *  @param[in] scope       (local) Scope of the exchange
+   *  @param[in] send_counts (local) Number of elements sent to each participant (length P)
+   *  @param[in] alg         (global) Algorithm selection
+   */
+  AlltoallvPlan( const Grid& grid, const Scope scope,
+                 const std::vector<int64_t>& send_counts,
+                 const AlltoallAlgorithm alg = AlltoallAlgorithm::Auto ) :
+    comm_( grid.internal_comm() ), members_( grid, scope ),
+    scounts_( send_counts ) {
+
+    if( int64_t(scounts_.size()) != members_.size() )
+      throw std::runtime_error("Send Counts Must Have One Entry Per Participant");
+
+    auto ex  = detail::exchange_counts( members_, comm_, scounts_.data() );
+    rcounts_ = std::move( ex.first );
+    sdispl_  = detail::displacements( scounts_ );
+    rdispl_  = detail::displacements( rcounts_ );
+    select( alg, ex.second );
+
+  }
+
+  /**
+   *  \brief Construct a plan with known recieve counts.
+   *
+   *  AlltoallAlgorithm::Auto requires a (max) reduction over the scope
+   *  to agree on the algorithm.
+   *
+   *  @param[in] grid        (local) BLACS grid which defined the communication context.
+   *  @param[in] scope       (local) Scope of the exchange
+   *  @param[in] send_counts (local) Number of elements sent to each participant (length P)
+   *  @param[in] recv_counts (local) Number of elements recieved from each participant (length P)
+   *  @param[in] alg         (global) Algorithm selection
+   */
+  AlltoallvPlan( const Grid& grid, const Scope scope,
+                 const std::vector<int64_t>& send_counts,
+                 const std::vector<int64_t>& recv_counts,
+                 const AlltoallAlgorithm alg = AlltoallAlgorithm::Auto ) :
+    comm_( grid.internal_comm() ), members_( grid, scope ),
+    scounts_( send_counts ), rcounts_( recv_counts ) {
+
+    if( int64_t(scounts_.size()) != members_.size() or
+        int64_t(rcounts_.size()) != members_.size() )
+      throw std::runtime_error("Counts Must Have One Entry Per Participant");
+
+    sdispl_ = detail::displacements( scounts_ );
+    rdispl_ = detail::displacements( rcounts_ );
+
+    int64_t mx = 0;
+    if( alg == AlltoallAlgorithm::Auto ) {
+      mx = *std::max_element( scounts_.begin(), scounts_.end() );
+      reduce2d( grid, scope, []( const int64_t& a, const int64_t& b ) {
+        return std::max( a, b );
+      }, 1, 1, &mx, 1 );
+    }
+    select( alg, mx );
+
+  }
+
+  /// Algorithm used by the plan
+  AlltoallAlgorithm algorithm() const noexcept { return algorithm_; }
+
+  /// Number of elements recieved from each participant
+  const std::vector<int64_t>& recv_counts() const noexcept { return rcounts_; }
+
+  /// Total number of elements sent
+  int64_t send_size() const noexcept { return sdispl_.back(); }
+
+  /// Total number of elements recieved
+  int64_t recv_size() const noexcept { return rdispl_.back(); }
+
+  /**
+   *  \brief Perform the exchange.
+   *
+   *  @param[in]  send_buf (local) Pointer to the packed send data (send_size())
+   *  @param[out] recv_buf (local) Pointer to the packed recieve data (recv_size())
+   */
+  void execute( const T* send_buf, T* recv_buf ) const {
+    if( algorithm_ == AlltoallAlgorithm::Bruck )
+      detail::alltoallv_bruck( members_, comm_, scounts_.data(), sdispl_.data(),
+        send_buf, rcounts_.data(), rdispl_.data(), recv_buf );
+    else
+      detail::alltoallv_pairwise( members_, comm_, scounts_.data(), sdispl_.data(),
+        send_buf, rcounts_.data(), rdispl_.data(), recv_buf );
+  }
+
+};
+
+
+/**
+ *  \brief Irregular all-to-all over a grid scope with known counts.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]  grid        (local) BLACS grid which defined the communication context.
+ *  @param[in]  scope       (local) Scope of the exchange
+ *  @param[in]  send_counts (local) Number of elements sent to each participant (length P)
+ *  @param[in]  send_buf    (local) Packed send data
+ *  @param[in]  recv_counts (local) Number of elements recieved from each participant (length P)
+ *  @param[out] recv_buf    (local) Packed recieve data
+ *  @param[in]  alg         (global) Algorithm selection
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  alltoallv2d( const Grid& grid, const Scope scope,
+               const std::vector<int64_t>& send_counts, const T* send_buf,
+               const std::vector<int64_t>& recv_counts, T* recv_buf,
+               const AlltoallAlgorithm alg = AlltoallAlgorithm::Auto ) {
+
+  AlltoallvPlan<T>( grid, scope, send_counts, recv_counts, alg )
+    .execute( send_buf, recv_buf );
+
+}
+
+/**
+ *  \brief Irregular all-to-all over a grid scope, exchanging counts.
+ *
+ *  Recieve counts are determined by a count-exchange step and the recieve
+ *  container is resized to fit.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffers.
+ *                    Must have Container::data(), Container::size() and
+ *                    Container::resize() member functions.
+ *
+ *  @param[in]  grid        (local) BLACS grid which defined the communication context.
+ *  @param[in]  scope       (local) Scope of the exchange
+ *  @param[in]  send_counts (local) Number of elements sent to each participant (length P)
+ *  @param[in]  send_buf    (local) Packed send data
+ *  @param[out] recv_counts (local) Number of elements recieved from each participant
+ *  @param[out] recv_buf    (local) Packed recieve data
+ *  @param[in]  alg         (global) Algorithm selection
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  alltoallv2d( const Grid& grid, const Scope scope,
+               const std::vector<int64_t>& send_counts, const Container& send_buf,
+               std::vector<int64_t>& recv_counts, Container& recv_buf,
+               const AlltoallAlgorithm alg = AlltoallAlgorithm::Auto ) {
+
+  using value_type = typename std::remove_cv< typename std::remove_reference<
+    decltype( *send_buf.data() ) >::type >::type;
+
+  AlltoallvPlan<value_type> plan( grid, scope, send_counts, alg );
+  recv_counts = plan.recv_counts();
+  recv_buf.resize( plan.recv_size() );
+  plan.execute( send_buf.data(), recv_buf.data() );
+
+}
+
+}
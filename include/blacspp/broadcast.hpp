@@ -8,6 +8,7 @@
 #include <blacspp/grid.hpp>
 #include <blacspp/wrappers/broadcast.hpp>
 #include <blacspp/util/type_conversions.hpp>
+#include <blacspp/util/transport.hpp>
 
 
 
@@ -42,6 +43,47 @@ detail::enable_if_blacs_supported_t<T>
 
 }
 
+/**
+ *  \brief General 2D broadcast send of a non-BLACS type.
+ *
+ *  Transports any trivially copyable T which is not BLACS enabled as a
+ *  stream of BLACS integers. Must be matched by gebr2d with the same T, M
+ *  and N.
+ *
+ *  @tparam T Type of buffer to send. Must be trivially copyable.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] top   (local) Topology of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_transportable_t<T>
+  gebs2d( const Grid& grid, const Scope scope, const Topology top,
+          const int64_t M, const int64_t N, const T* A, const int64_t LDA ) {
+
+  using transport = detail::blacs_transport<T>;
+  using word      = typename transport::word;
+
+  auto SCOPE = char( scope );
+  auto TOP   = char( top   );
+  if( transport::scaled() ) {
+    const auto k = transport::ratio();
+    wrappers::gebs2d( grid.context(), &SCOPE, &TOP, M*k, N, 
+                      reinterpret_cast<const word*>(A), 
+                      std::max<int64_t>( LDA*k, 1 ) );
+  } else {
+    auto buf = transport::pack( M, N, A, LDA );
+    wrappers::gebs2d( grid.context(), &SCOPE, &TOP, buf.size(), 1, buf.data(),
+                      buf.size() );
+  }
+
+}
+
 
 /**
  *  \brief General point-to-point 2D send.
@@ -194,16 +236,62 @@ detail::enable_if_t< detail::has_data_member<Container>::value >
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Pointer of buffer to store recieved data
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
  *
  */
 template <typename T>
 detail::enable_if_blacs_supported_t<T> 
   gebr2d( const Grid& grid, const Scope scope, const Topology top,
-          const int64_t M, const int64_t N, T* A, const int64_t LDA ) {
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RSRC, const int64_t CSRC ) {
+
+  auto SCOPE = char( scope );
+  auto TOP   = char( top   );
+  wrappers::gebr2d( grid.context(), &SCOPE, &TOP, M, N, A, LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve of a non-BLACS type.
+ *
+ *  Matches gebs2d of a trivially copyable, non-BLACS type.
+ *
+ *  @tparam T Type of buffer to recieve. Must be trivially copyable.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the broadcast
+ *  @param[in]     top   (local) Topology of the broadcast
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_transportable_t<T>
+  gebr2d( const Grid& grid, const Scope scope, const Topology top,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RSRC, const int64_t CSRC ) {
+
+  using transport = detail::blacs_transport<T>;
+  using word      = typename transport::word;
 
   auto SCOPE = char( scope );
   auto TOP   = char( top   );
-  wrappers::gebr2d( grid.context(), &SCOPE, &TOP, M, N, A, LDA );
+  if( transport::scaled() ) {
+    const auto k = transport::ratio();
+    wrappers::gebr2d( grid.context(), &SCOPE, &TOP, M*k, N, 
+                      reinterpret_cast<word*>(A), std::max<int64_t>( LDA*k, 1 ),
+                      RSRC, CSRC );
+  } else {
+    std::vector<word> buf( std::max<int64_t>( transport::packed_words( M, N ), 1 ) );
+    wrappers::gebr2d( grid.context(), &SCOPE, &TOP, buf.size(), 1, buf.data(),
+                      buf.size(), RSRC, CSRC );
+    transport::unpack( M, N, buf, A, LDA );
+  }
 
 }
 
@@ -224,14 +312,17 @@ detail::enable_if_blacs_supported_t<T>
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Recieve buffer (managed by some container)
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
  *
  */
 template <class Container>
 detail::enable_if_t< detail::has_data_member<Container>::value >
   gebr2d( const Grid& grid, const Scope scope, const Topology top,
-          const int64_t M, const int64_t N, Container& A, const int64_t LDA ) {
+          const int64_t M, const int64_t N, Container& A, const int64_t LDA,
+          const int64_t RSRC, const int64_t CSRC ) {
 
-  gebr2d( grid, scope, top, M, N, A.data(), LDA );
+  gebr2d( grid, scope, top, M, N, A.data(), LDA, RSRC, CSRC );
 
 }
 
@@ -250,13 +341,16 @@ detail::enable_if_t< detail::has_data_member<Container>::value >
  *
  *  @param[in]     grid  (local) BLACS grid which defined the communication context.
  *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
  *
  */
 template <class Container>
 detail::enable_if_t< detail::has_size_member<Container>::value >
-  gebr2d( const Grid& grid, const Scope scope, const Topology top, Container& A ) { 
+  gebr2d( const Grid& grid, const Scope scope, const Topology top, Container& A,
+          const int64_t RSRC, const int64_t CSRC ) { 
 
-  gebr2d( grid, scope, top, A.size(), 1, A, A.size() );
+  gebr2d( grid, scope, top, A.size(), 1, A, A.size(), RSRC, CSRC );
 
 }
 
@@ -277,20 +371,24 @@ detail::enable_if_t< detail::has_size_member<Container>::value >
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Pointer of buffer to store recieved data
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
  *
  */
 template <typename T>
 detail::enable_if_blacs_supported_t<T> 
   trbr2d( const Grid& grid, const Scope scope, const Topology top,
           const Uplo uplo, const Diag diag,
-          const int64_t M, const int64_t N, T* A, const int64_t LDA ) { 
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RSRC, const int64_t CSRC ) { 
 
   auto SCOPE = char( scope );
   auto TOP   = char( top   );
   auto UPLO  = char( uplo  );
   auto DIAG  = char( diag  );
 
-  wrappers::trbr2d( grid.context(), &SCOPE, &TOP, &UPLO, &DIAG, M, N, A, LDA );
+  wrappers::trbr2d( grid.context(), &SCOPE, &TOP, &UPLO, &DIAG, M, N, A, LDA,
+                    RSRC, CSRC );
 
 }
 
@@ -313,15 +411,18 @@ detail::enable_if_blacs_supported_t<T>
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Recieve buffer (managed by some container)
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
  *
  */
 template <class Container>
 detail::enable_if_t< detail::has_data_member<Container>::value >
   trbr2d( const Grid& grid, const Scope scope, const Topology top,
           const Uplo uplo, const Diag diag,
-          const int64_t M, const int64_t N, Container& A, const int64_t LDA ) {
+          const int64_t M, const int64_t N, Container& A, const int64_t LDA,
+          const int64_t RSRC, const int64_t CSRC ) {
 
-  trbr2d( grid, scope, top, uplo, diag, M, N, A.data(), LDA );
+  trbr2d( grid, scope, top, uplo, diag, M, N, A.data(), LDA, RSRC, CSRC );
 
 }
 
@@ -0,0 +1,315 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace blacspp {
+
+
+/**
+ *  \brief General 2D allgather over a grid scope (variable block sizes).
+ *
+ *  Each participant p of the scope contributes an M x N[p] block (col-major),
+ *  and every participant recieves the concatenation of all blocks, side by
+ *  side in scope order, as an M x sum(N) matrix. Participants are ordered by
+ *  grid coordinate along the scope (row-major for Scope::All).
+ *
+ *  Implemented as a ring: P-1 steps, each forwarding one block to the next
+ *  participant, so every process sends and recieves (P-1)/P of the result,
+ *  which is bandwidth optimal.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the allgather
+ *  @param[in]     M     (global) Number of rows of each block
+ *  @param[in]     N     (global) Number of columns contributed by each participant (length P)
+ *  @param[in]     A     (local) Pointer of the local M x N[me] block
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *  @param[in/out] B     (local) Pointer of M x sum(N) result buffer
+ *  @param[in]     LDB   (local) Leading dimension of B
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  allgather2d( const Grid& grid, const Scope scope, const int64_t M,
+               const int64_t* N, const T* A, const int64_t LDA,
+               T* B, const int64_t LDB ) {
+
+  detail::scope_members members( grid, scope );
+  const auto P  = members.size();
+  const auto me = members.me;
+
+  std::vector<int64_t> offset( P+1, 0 );
+  for( int64_t p = 0; p < P; ++p ) offset[p+1] = offset[p] + N[p];
+
+  // Place the local contribution
+  for( int64_t j = 0; j < N[me]; ++j )
+    std::copy_n( A + j*LDA, M, B + (offset[me] + j)*LDB );
+
+  auto wrap = [&]( int64_t i ) { return (i % P + P) % P; };
+  const auto right = members.shifted(  1 );
+  const auto left  = members.shifted( -1 );
+  const auto base  = detail::mpi_type<T>::type();
+
+  for( int64_t s = 0; s < P-1; ++s ) {
+
+    const auto sblk = wrap( me - s     );
+    const auto rblk = wrap( me - s - 1 );
+
+    auto stype = detail::matrix_type( base, M, N[sblk], LDB );
+    auto rtype = detail::matrix_type( base, M, N[rblk], LDB );
+
+    MPI_Sendrecv( B + offset[sblk]*LDB, 1, stype, right,
+                  internal::mpi_int(detail::Tag::Allgather),
+                  B + offset[rblk]*LDB, 1, rtype, left,
+                  internal::mpi_int(detail::Tag::Allgather),
+                  grid.internal_comm(), MPI_STATUS_IGNORE );
+
+    MPI_Type_free( &stype );
+    MPI_Type_free( &rtype );
+
+  }
+
+}
+
+/**
+ *  \brief General 2D allgather over a grid scope (uniform block sizes).
+ *
+ *  Every participant contributes an M x N block, B recieves M x (P*N).
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the allgather
+ *  @param[in]     M     (global) Number of rows of each block
+ *  @param[in]     N     (global) Number of columns of each block
+ *  @param[in]     A     (local) Pointer of the local M x N block
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *  @param[in/out] B     (local) Pointer of M x (P*N) result buffer
+ *  @param[in]     LDB   (local) Leading dimension of B
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  allgather2d( const Grid& grid, const Scope scope, const int64_t M,
+               const int64_t N, const T* A, const int64_t LDA,
+               T* B, const int64_t LDB ) {
+
+  std::vector<int64_t> NP( detail::scope_members( grid, scope ).size(), N );
+  allgather2d( grid, scope, M, NP.data(), A, LDA, B, LDB );
+
+}
+
+/**
+ *  \brief 1D allgather over a grid scope (uniform block sizes).
+ *
+ *  Buffers managed by C++ containers. B.size() must be P * A.size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffers.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the allgather
+ *  @param[in]     A     (local) Local contribution
+ *  @param[in/out] B     (local) Concatenated result
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  allgather2d( const Grid& grid, const Scope scope, const Container& A,
+               Container& B ) {
+
+  allgather2d( grid, scope, A.size(), 1, A.data(), A.size(), B.data(), A.size() );
+
+}
+
+/**
+ *  \brief 1D allgather over a grid scope (variable block sizes).
+ *
+ *  Buffers managed by C++ containers. Participant p contributes counts[p]
+ *  elements, B.size() must be at least sum(counts).
+ *
+ *  @tparam Container Type of container which manages the memory of the buffers.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid   (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope  (local) Scope of the allgather
+ *  @param[in]     counts (global) Number of elements contributed by each participant
+ *  @param[in]     A      (local) Local contribution
+ *  @param[in/out] B      (local) Concatenated result
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  allgather2d( const Grid& grid, const Scope scope,
+               const std::vector<int64_t>& counts, const Container& A,
+               Container& B ) {
+
+  allgather2d( grid, scope, 1, counts.data(), A.data(), 1, B.data(), 1 );
+
+}
+
+
+
+
+
+/**
+ *  \brief General 2D reduce-scatter (sum) over a grid scope (variable block sizes).
+ *
+ *  Every participant provides an M x sum(N) matrix A, viewed as blocks of
+ *  M x N[p] side by side in scope order. Participant p recieves in B the
+ *  element-wise sum over the scope of block p.
+ *
+ *  Implemented as a ring: P-1 steps, each forwarding one partially reduced
+ *  block to the next participant, so every process sends and recieves
+ *  (P-1)/P of A, which is bandwidth optimal.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduce-scatter
+ *  @param[in]     M     (global) Number of rows of each block
+ *  @param[in]     N     (global) Number of columns of each participant's block (length P)
+ *  @param[in]     A     (local) Pointer of the M x sum(N) contribution (unchanged)
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *  @param[in/out] B     (local) Pointer of the M x N[me] result block
+ *  @param[in]     LDB   (local) Leading dimension of B
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  reduce_scatter2d( const Grid& grid, const Scope scope, const int64_t M,
+                    const int64_t* N, const T* A, const int64_t LDA,
+                    T* B, const int64_t LDB ) {
+
+  detail::scope_members members( grid, scope );
+  const auto P  = members.size();
+  const auto me = members.me;
+
+  std::vector<int64_t> offset( P+1, 0 );
+  for( int64_t p = 0; p < P; ++p ) offset[p+1] = offset[p] + N[p];
+  const auto nmax = *std::max_element( N, N + P );
+
+  // Packed working copy of A and a recieve buffer for one block
+  std::vector<T> work( M * offset[P] ), recv( M * nmax );
+  for( int64_t j = 0; j < offset[P]; ++j )
+    std::copy_n( A + j*LDA, M, work.data() + j*M );
+
+  auto wrap = [&]( int64_t i ) { return (i % P + P) % P; };
+  const auto right = members.shifted(  1 );
+  const auto left  = members.shifted( -1 );
+  const auto base  = detail::mpi_type<T>::type();
+
+  for( int64_t s = 0; s < P-1; ++s ) {
+
+    const auto sblk = wrap( me - s - 1 );
+    const auto rblk = wrap( me - s - 2 );
+
+    MPI_Sendrecv( work.data() + offset[sblk]*M, M*N[sblk], base, right,
+                  internal::mpi_int(detail::Tag::ReduceScatter),
+                  recv.data(), M*N[rblk], base, left,
+                  internal::mpi_int(detail::Tag::ReduceScatter),
+                  grid.internal_comm(), MPI_STATUS_IGNORE );
+
+    auto* acc = work.data() + offset[rblk]*M;
+    for( int64_t i = 0; i < M*N[rblk]; ++i ) acc[i] += recv[i];
+
+  }
+
+  for( int64_t j = 0; j < N[me]; ++j )
+    std::copy_n( work.data() + (offset[me] + j)*M, M, B + j*LDB );
+
+}
+
+/**
+ *  \brief General 2D reduce-scatter (sum) over a grid scope (uniform block sizes).
+ *
+ *  A is M x (P*N), B recieves the M x N sum of block me.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduce-scatter
+ *  @param[in]     M     (global) Number of rows of each block
+ *  @param[in]     N     (global) Number of columns of each block
+ *  @param[in]     A     (local) Pointer of the M x (P*N) contribution (unchanged)
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *  @param[in/out] B     (local) Pointer of the M x N result block
+ *  @param[in]     LDB   (local) Leading dimension of B
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  reduce_scatter2d( const Grid& grid, const Scope scope, const int64_t M,
+                    const int64_t N, const T* A, const int64_t LDA,
+                    T* B, const int64_t LDB ) {
+
+  std::vector<int64_t> NP( detail::scope_members( grid, scope ).size(), N );
+  reduce_scatter2d( grid, scope, M, NP.data(), A, LDA, B, LDB );
+
+}
+
+/**
+ *  \brief 1D reduce-scatter (sum) over a grid scope (uniform block sizes).
+ *
+ *  Buffers managed by C++ containers. A.size() must be P * B.size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffers.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduce-scatter
+ *  @param[in]     A     (local) Local contribution
+ *  @param[in/out] B     (local) Reduced block of this participant
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  reduce_scatter2d( const Grid& grid, const Scope scope, const Container& A,
+                    Container& B ) {
+
+  reduce_scatter2d( grid, scope, B.size(), 1, A.data(), B.size(), B.data(), B.size() );
+
+}
+
+/**
+ *  \brief 1D reduce-scatter (sum) over a grid scope (variable block sizes).
+ *
+ *  Buffers managed by C++ containers. Participant p recieves counts[p]
+ *  elements, A.size() must be at least sum(counts).
+ *
+ *  @tparam Container Type of container which manages the memory of the buffers.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid   (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope  (local) Scope of the reduce-scatter
+ *  @param[in]     counts (global) Number of elements recieved by each participant
+ *  @param[in]     A      (local) Local contribution
+ *  @param[in/out] B      (local) Reduced block of this participant
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  reduce_scatter2d( const Grid& grid, const Scope scope,
+                    const std::vector<int64_t>& counts, const Container& A,
+                    Container& B ) {
+
+  reduce_scatter2d( grid, scope, 1, counts.data(), A.data(), 1, B.data(), 1 );
+
+}
+
+}
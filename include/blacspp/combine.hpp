@@ -0,0 +1,326 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/reduce.hpp>
+#include <blacspp/wrappers/combine.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace blacspp {
+
+namespace detail {
+
+  /**
+   *  \brief A SFINAE struct to check if an integer type is reduced natively
+   *  by blacspp rather than BLACS.
+   *
+   *  BLACS only provides integer combines for blacs_int. The following
+   *  types are reduced in their own width (no widening copy) by reduce2d:
+   *    - int8_t, uint8_t
+   *    - int32_t, int64_t (whichever is not blacs_int)
+   */
+  template <typename T>
+  struct native_reducible : public std::false_type { };
+
+  template<>
+  struct native_reducible< int8_t  > : public std::true_type { };
+  template<>
+  struct native_reducible< uint8_t > : public std::true_type { };
+  template<>
+  struct native_reducible< int32_t > : 
+    public std::integral_constant< bool, not blacs_supported<int32_t>::value > { };
+  template<>
+  struct native_reducible< int64_t > : 
+    public std::integral_constant< bool, not blacs_supported<int64_t>::value > { };
+
+  template <typename T, typename U = void>
+  using enable_if_native_reducible_t = 
+    typename std::enable_if< native_reducible<T>::value, U >::type;
+
+  /// Absolute value of an integer as its unsigned type (exact for the most negative value)
+  template <typename T>
+  typename std::make_unsigned<T>::type magnitude( const T& a ) {
+    using U = typename std::make_unsigned<T>::type;
+    return a < T(0) ? U( U(0) - U(a) ) : U(a);
+  }
+
+  /// Element of larger absolute value (the larger signed value on ties, so that the result is independent of the reduction order)
+  template <typename T>
+  struct absmax_op {
+    T operator()( const T& a, const T& b ) const { 
+      const auto ma = magnitude( a ), mb = magnitude( b );
+      return ma != mb ? ( ma > mb ? a : b ) : std::max( a, b );
+    }
+  };
+
+  /// Element of smaller absolute value (the larger signed value on ties)
+  template <typename T>
+  struct absmin_op {
+    T operator()( const T& a, const T& b ) const { 
+      const auto ma = magnitude( a ), mb = magnitude( b );
+      return ma != mb ? ( ma < mb ? a : b ) : std::max( a, b );
+    }
+  };
+
+}
+
+
+/**
+ *  \brief General 2D element-wise sum.
+ *
+ *  Sums an M x N buffer (col-major) element-wise over the specified scope.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  gsum2d( const Grid& grid, const Scope scope, const Topology top,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  auto SCOPE = char( scope );
+  auto TOP   = char( top   );
+  wrappers::gsum2d( grid.context(), &SCOPE, &TOP, M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum of non-BLACS integers.
+ *
+ *  Reduced by reduce2d in the native type, sums wrap as the native type.
+ *  Topology is ignored.
+ *
+ *  @tparam T Type of buffer. Must be int8_t, uint8_t, int32_t or int64_t.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination
+ *
+ */
+template <typename T>
+detail::enable_if_native_reducible_t<T>
+  gsum2d( const Grid& grid, const Scope scope, const Topology /*top*/,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  reduce2d( grid, scope, std::plus<T>(), M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum.
+ *
+ *  Element locations are not returned (BLACS RCFLAG = -1).
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  auto SCOPE = char( scope );
+  auto TOP   = char( top   );
+  wrappers::gamx2d( grid.context(), &SCOPE, &TOP, M, N, A, LDA, nullptr, 
+                    nullptr, -1, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum of non-BLACS integers.
+ *
+ *  Reduced by reduce2d in the native type. As in BLACS, the element of 
+ *  largest absolute value is kept (with its sign). Topology is ignored.
+ *
+ *  @tparam T Type of buffer. Must be int8_t, uint8_t, int32_t or int64_t.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination
+ *
+ */
+template <typename T>
+detail::enable_if_native_reducible_t<T>
+  gamx2d( const Grid& grid, const Scope scope, const Topology /*top*/,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  reduce2d( grid, scope, detail::absmax_op<T>(), M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum.
+ *
+ *  Element locations are not returned (BLACS RCFLAG = -1).
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  auto SCOPE = char( scope );
+  auto TOP   = char( top   );
+  wrappers::gamn2d( grid.context(), &SCOPE, &TOP, M, N, A, LDA, nullptr, 
+                    nullptr, -1, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum of non-BLACS integers.
+ *
+ *  Reduced by reduce2d in the native type. As in BLACS, the element of 
+ *  smallest absolute value is kept (with its sign). Topology is ignored.
+ *
+ *  @tparam T Type of buffer. Must be int8_t, uint8_t, int32_t or int64_t.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination
+ *
+ */
+template <typename T>
+detail::enable_if_native_reducible_t<T>
+  gamn2d( const Grid& grid, const Scope scope, const Topology /*top*/,
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  reduce2d( grid, scope, detail::absmin_op<T>(), M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief Element-wise sum over all elements of a container.
+ *
+ *  Result is recieved by all participants of the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in/out] A     (local) Buffer to reduce
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  gsum2d( const Grid& grid, const Scope scope, const Topology top, 
+          Container& A ) {
+
+  gsum2d( grid, scope, top, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Element-wise maximum over all elements of a container.
+ *
+ *  Result is recieved by all participants of the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in/out] A     (local) Buffer to reduce
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  gamx2d( const Grid& grid, const Scope scope, const Topology top, 
+          Container& A ) {
+
+  gamx2d( grid, scope, top, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Element-wise minimum over all elements of a container.
+ *
+ *  Result is recieved by all participants of the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     top   (local) Topology of the reduction
+ *  @param[in/out] A     (local) Buffer to reduce
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  gamn2d( const Grid& grid, const Scope scope, const Topology top, 
+          Container& A ) {
+
+  gamn2d( grid, scope, top, A.size(), 1, A.data(), A.size() );
+
+}
+
+}
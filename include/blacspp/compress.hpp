@@ -0,0 +1,258 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Options for compressed transfers.
+ */
+struct CompressionOptions {
+  int64_t threshold = 64 * 1024; ///< Minimum message size (bytes) to attempt compression
+  bool    delta     = true;      ///< Delta-code integer data before shuffling
+};
+
+/**
+ *  \brief Outcome of a compressed transfer.
+ */
+struct CompressionStats {
+  int64_t raw_bytes  = 0;     ///< Size of the uncompressed data
+  int64_t wire_bytes = 0;     ///< Size of the message sent (including header)
+  bool    compressed = false; ///< Whether the compressed encoding was used
+
+  /// Achieved compression ratio (raw / wire)
+  inline double ratio() const noexcept {
+    return wire_bytes ? double(raw_bytes) / double(wire_bytes) : 1.;
+  }
+};
+
+namespace detail {
+
+  /**
+   *  \brief Encode a contiguous buffer for transfer.
+   *
+   *  The message is a small header followed by either the raw bytes or the
+   *  compressed encoding: optional delta coding of integer elements, a
+   *  byte-shuffle (grouping the k-th byte of every element), then a
+   *  PackBits-style run-length code. Falls back to raw bytes when the
+   *  buffer is below opts.threshold or does not compress.
+   *
+   *  @param[in]  data      Buffer to encode
+   *  @param[in]  nelem     Number of elements
+   *  @param[in]  elem_size Size of each element in bytes
+   *  @param[in]  integral  Whether the elements are integers (delta coding)
+   *  @param[in]  opts      Compression options
+   *  @param[out] msg       Encoded message
+   *  @returns Statistics of the encoding
+   */
+  CompressionStats compress( const void* data, int64_t nelem, int64_t elem_size,
+    bool integral, const CompressionOptions& opts, std::vector<uint8_t>& msg );
+
+  /**
+   *  \brief Decode a message produced by compress.
+   *
+   *  Throws if the message does not describe nelem elements of elem_size.
+   *
+   *  @param[in]  msg       Encoded message
+   *  @param[in]  nbytes    Size of the encoded message
+   *  @param[out] data      Decoded buffer
+   *  @param[in]  nelem     Number of elements
+   *  @param[in]  elem_size Size of each element in bytes
+   */
+  void decompress( const uint8_t* msg, int64_t nbytes, void* data,
+    int64_t nelem, int64_t elem_size );
+
+  template <typename T>
+  using integral_tag = std::integral_constant< bool, std::is_integral<T>::value >;
+
+  template <typename T>
+  void pack_contiguous( const int64_t M, const int64_t N, const T* A,
+    const int64_t LDA, std::vector<T>& buf ) {
+    buf.resize( M*N );
+    for( int64_t j = 0; j < N; ++j ) 
+      std::copy_n( A + j*LDA, M, buf.data() + j*M );
+  }
+
+  template <typename T>
+  void unpack_contiguous( const int64_t M, const int64_t N, 
+    const std::vector<T>& buf, T* A, const int64_t LDA ) {
+    for( int64_t j = 0; j < N; ++j ) 
+      std::copy_n( buf.data() + j*M, M, A + j*LDA );
+  }
+
+  // Matched probe: the message sized by the probe is the one recieved, even
+  // if other threads recieve from the same source and tag concurrently
+  inline std::vector<uint8_t> probe_recv( const int64_t src, const Tag tag,
+    MPI_Comm comm ) {
+    MPI_Message message;
+    MPI_Status  status;
+    internal::mpi_int nbytes;
+    MPI_Mprobe( src, internal::mpi_int(tag), comm, &message, &status );
+    MPI_Get_count( &status, MPI_BYTE, &nbytes );
+    std::vector<uint8_t> msg( nbytes );
+    MPI_Mrecv( msg.data(), nbytes, MPI_BYTE, &message, MPI_STATUS_IGNORE );
+    return msg;
+  }
+
+}
+
+/**
+ *  \brief Point-to-point 2D send with optional lossless compression.
+ *
+ *  Messages at least opts.threshold bytes in size are compressed with a
+ *  built-in codec (delta + byte-shuffle + run-length), which works well
+ *  for index arrays and data with long zero (or constant) runs; data
+ *  which does not compress is sent raw. Must be matched by
+ *  gerv2d_compressed.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @param[in] opts  (local) Compression options
+ *
+ *  @returns Size and compression ratio of the message sent
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, CompressionStats >
+  gesd2d_compressed( const Grid& grid, const int64_t M, const int64_t N,
+                     const T* A, const int64_t LDA, const int64_t RDEST,
+                     const int64_t CDEST,
+                     const CompressionOptions& opts = CompressionOptions() ) {
+
+  std::vector<T>       buf;
+  std::vector<uint8_t> msg;
+  detail::pack_contiguous( M, N, A, LDA, buf );
+  auto stats = detail::compress( buf.data(), M*N, sizeof(T), 
+    detail::integral_tag<T>::value, opts, msg );
+
+  MPI_Send( msg.data(), msg.size(), MPI_BYTE, grid.comm_rank( RDEST, CDEST ),
+            internal::mpi_int(detail::Tag::Compressed), grid.internal_comm() );
+  return stats;
+
+}
+
+/**
+ *  \brief Point-to-point 2D recieve of a (possibly) compressed message.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]  grid (local) BLACS grid which defined the communication context.
+ *  @param[in]  M    (local) Number of rows of the buffer to recieve
+ *  @param[in]  N    (local) Number of columns of the buffer to recieve
+ *  @param[out] A    (local) Pointer of buffer to recieve into
+ *  @param[in]  LDA  (local) Leading dimension of the buffer to recieve
+ *  @param[in]  RSRC (local) Process row coordinate of source process
+ *  @param[in]  CSRC (local) Process column coordinate of source process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  gerv2d_compressed( const Grid& grid, const int64_t M, const int64_t N,
+                     T* A, const int64_t LDA, const int64_t RSRC,
+                     const int64_t CSRC ) {
+
+  auto msg = detail::probe_recv( grid.comm_rank( RSRC, CSRC ), 
+    detail::Tag::Compressed, grid.internal_comm() );
+
+  std::vector<T> buf( M*N );
+  detail::decompress( msg.data(), msg.size(), buf.data(), M*N, sizeof(T) );
+  detail::unpack_contiguous( M, N, buf, A, LDA );
+
+}
+
+/**
+ *  \brief 2D broadcast send with optional lossless compression.
+ *
+ *  The buffer is encoded once and the same message sent to every other
+ *  participant of the scope. Must be matched by gebr2d_compressed.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] opts  (local) Compression options
+ *
+ *  @returns Size and compression ratio of the message sent
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, CompressionStats >
+  gebs2d_compressed( const Grid& grid, const Scope scope, const int64_t M,
+                     const int64_t N, const T* A, const int64_t LDA,
+                     const CompressionOptions& opts = CompressionOptions() ) {
+
+  detail::scope_members members( grid, scope );
+
+  std::vector<T>       buf;
+  std::vector<uint8_t> msg;
+  detail::pack_contiguous( M, N, A, LDA, buf );
+  auto stats = detail::compress( buf.data(), M*N, sizeof(T), 
+    detail::integral_tag<T>::value, opts, msg );
+
+  std::vector<MPI_Request> reqs( members.size() - 1 );
+  for( int64_t i = 1; i < members.size(); ++i )
+    MPI_Isend( msg.data(), msg.size(), MPI_BYTE, members.shifted( i ),
+               internal::mpi_int(detail::Tag::CompressedBroadcast),
+               grid.internal_comm(), &reqs[i-1] );
+  MPI_Waitall( reqs.size(), reqs.data(), MPI_STATUSES_IGNORE );
+
+  return stats;
+
+}
+
+/**
+ *  \brief 2D broadcast recieve of a (possibly) compressed message.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]  grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]  scope (local) Scope of the broadcast
+ *  @param[in]  M     (local) Number of rows of the buffer to recieve
+ *  @param[in]  N     (local) Number of columns of the buffer to recieve
+ *  @param[out] A     (local) Pointer of buffer to recieve into
+ *  @param[in]  LDA   (local) Leading dimension of the buffer to recieve
+ *  @param[in]  RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]  CSRC  (local) Process column coordinate of the broadcast root
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  gebr2d_compressed( const Grid& grid, const Scope scope, const int64_t M,
+                     const int64_t N, T* A, const int64_t LDA,
+                     const int64_t RSRC, const int64_t CSRC ) {
+
+  if( not detail::in_scope( grid, scope, RSRC, CSRC ) )
+    throw std::runtime_error("gebr2d_compressed: broadcast root is not in the scope");
+
+  auto msg = detail::probe_recv( grid.comm_rank( RSRC, CSRC ), 
+    detail::Tag::CompressedBroadcast, grid.internal_comm() );
+
+  std::vector<T> buf( M*N );
+  detail::decompress( msg.data(), msg.size(), buf.data(), M*N, sizeof(T) );
+  detail::unpack_contiguous( M, N, buf, A, LDA );
+
+}
+
+}
@@ -0,0 +1,229 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+
+// Optional C++20 interface, the remainder of blacspp only requires C++11
+#if __cplusplus < 202002L || !defined(__cpp_impl_coroutine)
+#error "blacspp/coroutine.hpp requires C++20 coroutine support"
+#endif
+
+#include <blacspp/nonblocking.hpp>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+class Scheduler;
+
+/**
+ *  \brief Coroutine type for tasks which await blacspp communication.
+ *
+ *  Tasks are lazily started: they begin executing once handed to a
+ *  Scheduler via Scheduler::spawn.
+ */
+class Task {
+
+public:
+
+  struct promise_type {
+
+    Scheduler*         scheduler = nullptr; ///< Scheduler which owns the task
+    std::exception_ptr exception = nullptr; ///< Exception escaping the task
+
+    Task get_return_object() {
+      return Task( std::coroutine_handle<promise_type>::from_promise(*this) );
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend()   noexcept { return {}; }
+
+    void return_void() noexcept { }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+  };
+
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  Task( Task&& other ) noexcept : handle_( std::exchange( other.handle_, nullptr ) ) { }
+  Task( const Task& ) = delete;
+
+  ~Task() noexcept { if( handle_ ) handle_.destroy(); }
+
+private:
+
+  explicit Task( handle_type h ) : handle_(h) { }
+
+  handle_type handle_; ///< Coroutine handle (owned until spawned)
+
+  friend class Scheduler;
+
+};
+
+
+/**
+ *  \brief Single-threaded scheduler for communication-bound coroutines.
+ *
+ *  Polls the requests which suspended tasks are waiting on and resumes the
+ *  tasks whose requests have completed. Lets a single thread keep many
+ *  transfers in flight without a thread per transfer.
+ */
+class Scheduler {
+
+  struct Waiter {
+    Request                 request; ///< Request being awaited
+    std::coroutine_handle<> handle;  ///< Coroutine to resume on completion
+  };
+
+  std::deque<Waiter>                   waiting_; ///< Suspended on a request
+  std::deque<std::coroutine_handle<>>  ready_;   ///< Ready to be resumed
+  std::vector<Task::handle_type>       tasks_;   ///< Owned (unfinished) tasks
+
+public:
+
+  Scheduler() = default;
+  Scheduler( const Scheduler& ) = delete;
+
+  ~Scheduler() noexcept { for( auto h : tasks_ ) h.destroy(); }
+
+  /**
+   *  \brief Take ownership of a task and schedule it for execution.
+   *  @param[in] task Task to execute
+   */
+  void spawn( Task&& task ) {
+    auto h = std::exchange( task.handle_, nullptr );
+    h.promise().scheduler = this;
+    tasks_.emplace_back( h );
+    ready_.emplace_back( h );
+  }
+
+  /**
+   *  \brief Suspend a coroutine until a request completes.
+   *
+   *  @param[in] request Request to await
+   *  @param[in] h       Coroutine to resume once request has completed
+   */
+  void suspend( Request request, std::coroutine_handle<> h ) {
+    waiting_.push_back( Waiter{ std::move(request), h } );
+  }
+
+  /**
+   *  \brief Number of requests currently awaited.
+   */
+  std::size_t in_flight() const noexcept { return waiting_.size(); }
+
+  /**
+   *  \brief Make one pass over outstanding work.
+   *
+   *  Tests every awaited request, resumes all ready coroutines and reaps
+   *  finished tasks. Rethrows the first exception which escaped a task.
+   *
+   *  @returns Whether unfinished tasks remain
+   */
+  bool poll() {
+
+    for( auto it = waiting_.begin(); it != waiting_.end(); ) {
+      if( it->request.test() ) {
+        ready_.emplace_back( it->handle );
+        it = waiting_.erase( it );
+      } else ++it;
+    }
+
+    while( ready_.size() ) {
+      auto h = ready_.front();
+      ready_.pop_front();
+      h.resume();
+    }
+
+    std::exception_ptr exception = nullptr;
+    for( auto it = tasks_.begin(); it != tasks_.end(); ) {
+      if( it->done() ) {
+        if( not exception ) exception = it->promise().exception;
+        it->destroy();
+        it = tasks_.erase( it );
+      } else ++it;
+    }
+    if( exception ) std::rethrow_exception( exception );
+
+    return tasks_.size();
+
+  }
+
+  /**
+   *  \brief Run until every spawned task has finished.
+   */
+  void run() { while( poll() ); }
+
+};
+
+
+/**
+ *  \brief Awaitable wrapper around a blacspp Request.
+ *
+ *  May only be awaited from within a blacspp::Task.
+ */
+class RequestAwaitable {
+
+  Request request_;
+
+public:
+
+  explicit RequestAwaitable( Request request ) : request_( std::move(request) ) { }
+
+  bool await_ready() { return request_.test(); }
+
+  void await_suspend( Task::handle_type h ) {
+    h.promise().scheduler->suspend( std::move(request_), h );
+  }
+
+  void await_resume() const noexcept { }
+
+};
+
+/**
+ *  \brief Await an arbitrary blacspp Request.
+ *  @param[in] request Request to await
+ */
+inline RequestAwaitable awaitable( Request request ) {
+  return RequestAwaitable( std::move(request) );
+}
+
+/**
+ *  \brief Awaitable general point-to-point 2D send (see igesd2d).
+ */
+template <typename... Args>
+RequestAwaitable async_gesd2d( const Grid& grid, Args&&... args ) {
+  return RequestAwaitable( igesd2d( grid, std::forward<Args>(args)... ) );
+}
+
+/**
+ *  \brief Awaitable general point-to-point 2D recieve (see igerv2d).
+ */
+template <typename... Args>
+RequestAwaitable async_gerv2d( const Grid& grid, Args&&... args ) {
+  return RequestAwaitable( igerv2d( grid, std::forward<Args>(args)... ) );
+}
+
+/**
+ *  \brief Awaitable general 2D broadcast send (see igebs2d).
+ */
+template <typename... Args>
+RequestAwaitable async_gebs2d( const Grid& grid, Args&&... args ) {
+  return RequestAwaitable( igebs2d( grid, std::forward<Args>(args)... ) );
+}
+
+/**
+ *  \brief Awaitable general 2D broadcast recieve (see igebr2d).
+ */
+template <typename... Args>
+RequestAwaitable async_gebr2d( const Grid& grid, Args&&... args ) {
+  return RequestAwaitable( igebr2d( grid, std::forward<Args>(args)... ) );
+}
+
+}
@@ -0,0 +1,148 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Communication primitives described by a CostModel.
+ */
+enum class Primitive : char {
+  PointToPoint = 'P', ///< gesd2d / gerv2d
+  Broadcast    = 'B', ///< gebs2d / gebr2d
+  Sum          = 'S'  ///< gsum2d (result on all participants)
+};
+
+/**
+ *  \brief Alpha-beta (latency-bandwidth) cost of a communication.
+ *
+ *  Time (s) of a bytes message is alpha + beta * bytes.
+ */
+struct AlphaBeta {
+  double alpha = 0.; ///< Latency (s)
+  double beta  = 0.; ///< Inverse bandwidth (s / byte)
+
+  inline double operator()( double bytes ) const noexcept {
+    return alpha + beta * bytes;
+  }
+};
+
+/**
+ *  \brief Options for CostModel calibration.
+ */
+struct CostModelOptions {
+  std::vector<int64_t>  message_bytes = { 8, 1 << 10, 1 << 14, 1 << 18 };
+  int64_t               repetitions   = 5; ///< Timed runs per message size (fastest is kept)
+  std::vector<Topology> topologies    = { Topology::Default, Topology::IRing, 
+    Topology::DRing, Topology::SRing, Topology::MRing, Topology::Hypercube,
+    Topology::Tree }; ///< Broadcast topologies to fit
+};
+
+/**
+ *  \brief Measured alpha-beta cost model of the communication on a BLACS grid.
+ *
+ *  One fit is kept per primitive, scope and (for broadcasts) topology.
+ *  Point-to-point costs are those of an exchange between the first and last
+ *  participants of the scope while every row (column) exchanges concurrently,
+ *  broadcasts are rooted at the first participant of the scope and sums
+ *  leave the result on all participants. Scopes with a single participant
+ *  cost nothing.
+ */
+class CostModel {
+
+  using key_type = std::tuple< Primitive, Scope, Topology >;
+  std::map< key_type, AlphaBeta > fits_;
+
+public:
+
+  /**
+   *  \brief Construct an empty cost model.
+   *
+   *  Fits may be provided by set (e.g. from a previous calibration).
+   */
+  CostModel() = default;
+
+  /**
+   *  \brief Calibrate a cost model on a BLACS grid.
+   *
+   *  Collective over the grid. Runs a short micro-benchmark of every
+   *  primitive on every scope over opts.message_bytes and fits alpha and
+   *  beta by (non-negative) least squares to the slowest process' times.
+   *  The resulting model is identical on all processes.
+   *
+   *  @param[in] grid BLACS grid to calibrate
+   *  @param[in] opts Calibration options
+   */
+  explicit CostModel( const Grid& grid, 
+                      const CostModelOptions& opts = CostModelOptions() );
+
+  /**
+   *  \brief Check if a fit exists.
+   *
+   *  @param[in] prim  Communication primitive
+   *  @param[in] scope Scope of the communication
+   *  @param[in] top   Topology (broadcasts only)
+   *  @returns         Whether the model holds a fit for (prim,scope,top)
+   */
+  bool contains( Primitive prim, Scope scope, 
+                 Topology top = Topology::Default ) const;
+
+  /**
+   *  \brief Returns a fit.
+   *
+   *  Throws if the model holds no fit for (prim,scope,top).
+   *
+   *  @param[in] prim  Communication primitive
+   *  @param[in] scope Scope of the communication
+   *  @param[in] top   Topology (broadcasts only)
+   *  @returns         Fitted alpha-beta parameters
+   */
+  AlphaBeta fit( Primitive prim, Scope scope, 
+                 Topology top = Topology::Default ) const;
+
+  /**
+   *  \brief Replace a fit.
+   *
+   *  @param[in] prim  Communication primitive
+   *  @param[in] scope Scope of the communication
+   *  @param[in] top   Topology (broadcasts only)
+   *  @param[in] ab    Alpha-beta parameters
+   */
+  void set( Primitive prim, Scope scope, Topology top, AlphaBeta ab );
+
+  /**
+   *  \brief Predicted time of a communication.
+   *
+   *  Throws if the model holds no fit for (prim,scope,top).
+   *
+   *  @param[in] prim  Communication primitive
+   *  @param[in] scope Scope of the communication
+   *  @param[in] bytes Message size in bytes
+   *  @param[in] top   Topology (broadcasts only)
+   *  @returns         Predicted time (s)
+   */
+  inline double predict( Primitive prim, Scope scope, double bytes,
+                         Topology top = Topology::Default ) const {
+    return fit( prim, scope, top )( bytes );
+  }
+
+  /**
+   *  \brief Fastest calibrated broadcast topology for a message size.
+   *
+   *  @param[in] scope Scope of the broadcast
+   *  @param[in] bytes Message size in bytes
+   *  @returns         Topology with the smallest predicted time
+   */
+  Topology best_broadcast( Scope scope, double bytes ) const;
+
+};
+
+}
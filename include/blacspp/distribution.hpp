@@ -0,0 +1,75 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+namespace blacspp {
+
+/**
+ *  \brief 2D block-cyclic distribution of a matrix (as a ScaLAPACK descriptor).
+ *
+ *  Element (i,j) of the M x N global matrix (0-based) belongs to block
+ *  (i / MB, j / NB), which lives on process ((i/MB + RSRC) % npr, 
+ *  (j/NB + CSRC) % npc). Local matrices are stored col-major.
+ */
+struct BlockCyclic {
+
+  int64_t M;    ///< Number of global rows
+  int64_t N;    ///< Number of global columns
+  int64_t MB;   ///< Row blocking factor
+  int64_t NB;   ///< Column blocking factor
+  int64_t RSRC; ///< Process row owning the first row block
+  int64_t CSRC; ///< Process column owning the first column block
+
+  BlockCyclic( int64_t _M, int64_t _N, int64_t _MB, int64_t _NB,
+               int64_t _RSRC = 0, int64_t _CSRC = 0 ) :
+    M(_M), N(_N), MB(_MB), NB(_NB), RSRC(_RSRC), CSRC(_CSRC) { }
+
+  /**
+   *  \brief Number of rows or columns of a dimension owned by a process (NUMROC).
+   *
+   *  @param[in] n     Global extent
+   *  @param[in] nb    Blocking factor
+   *  @param[in] iproc Process coordinate
+   *  @param[in] isrc  Process coordinate owning the first block
+   *  @param[in] nproc Number of processes along the dimension
+   *  @returns         Local extent on iproc
+   */
+  static inline int64_t numroc( int64_t n, int64_t nb, int64_t iproc, 
+    int64_t isrc, int64_t nproc ) noexcept {
+    const int64_t dist   = (iproc - isrc + nproc) % nproc;
+    const int64_t nblk   = n / nb;
+    int64_t       nloc   = (nblk / nproc) * nb;
+    const int64_t extra  = nblk % nproc;
+    if( dist < extra )       nloc += nb;
+    else if( dist == extra ) nloc += n % nb;
+    return nloc;
+  }
+
+  /// Number of local rows on process row PROW of grid
+  inline int64_t local_rows( const Grid& grid, int64_t PROW ) const noexcept {
+    return numroc( M, MB, PROW, RSRC, grid.npr() );
+  }
+
+  /// Number of local columns on process column PCOL of grid
+  inline int64_t local_cols( const Grid& grid, int64_t PCOL ) const noexcept {
+    return numroc( N, NB, PCOL, CSRC, grid.npc() );
+  }
+
+  /// Number of local rows on this process
+  inline int64_t local_rows( const Grid& grid ) const noexcept {
+    return local_rows( grid, grid.ipr() );
+  }
+
+  /// Number of local columns on this process
+  inline int64_t local_cols( const Grid& grid ) const noexcept {
+    return local_cols( grid, grid.ipc() );
+  }
+
+};
+
+}
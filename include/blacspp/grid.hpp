@@ -7,6 +7,8 @@
 #pragma once
 #include <blacspp/types.hpp>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace blacspp {
 
@@ -19,15 +21,76 @@ struct Context {
   int64_t system_handle = -1;
   int64_t blacs_handle  = -1;
 
-  Context(MPI_Comm comm);
+  bool owns_comm = false; ///< Whether the MPI communicator is freed with the context
+  bool owns_grid = true;  ///< Whether the BLACS context is exited with the context
+
+  /**
+   *  Private duplicate of the MPI communicator for MPI-backed operations.
+   *
+   *  Duplicated eagerly, which adds one collective MPI_Comm_dup to the
+   *  creation of every grid (see Grid::batch to overlap them). It cannot be
+   *  deferred to first use: the first MPI-backed operation (e.g. igesd2d)
+   *  is in general not called by all processes of the grid.
+   */
+  MPI_Comm internal_comm = MPI_COMM_NULL;
+
+  /// MPI rank (in mpi.comm()) of each process coordinate (col-major, npr x npc)
+  std::vector<int64_t> rank_map;
+
+  /// Context owning the system handle if it is shared (batched creation)
+  std::shared_ptr<const Context> system_owner = nullptr;
+
+  Context(MPI_Comm comm, bool _owns_comm = false);
+
+  /// Take ownership of comm and share the system handle of owner (internal_comm is left null)
+  Context(MPI_Comm comm, std::shared_ptr<const Context> owner);
   ~Context() noexcept;
 
   std::shared_ptr<Context> clone() const;
+  std::shared_ptr<Context> duplicate() const;
+
+  /// Wrap an existing BLACS context, grid_dim receives its grid info
+  static std::shared_ptr<Context> adopt( int64_t blacs_handle, blacs_grid_dim& grid_dim );
+
+private:
+
+  std::shared_ptr<Context> map_onto( MPI_Comm comm, bool _owns_comm ) const;
 
 };
 
 }
 
+/**
+ *  \brief Description of one BLACS grid of a batch (see Grid::batch).
+ */
+struct GridSpec {
+
+  int64_t npr; ///< Number of process rows
+  int64_t npc; ///< Number of process columns
+
+  /// MPI rank of each process coordinate (col-major, npr x npc)
+  std::vector<int64_t> map;
+
+  /**
+   *  \brief Grid over the first npr * npc ranks in the given order.
+   *
+   *  @param[in] _npr  Number of process rows
+   *  @param[in] _npc  Number of process columns
+   *  @param[in] order Order in which ranks are assigned to coordinates
+   */
+  GridSpec( int64_t _npr, int64_t _npc, GridOrder order = GridOrder::RowMajor );
+
+  /**
+   *  \brief Grid over an explicit process map.
+   *
+   *  @param[in] _npr Number of process rows
+   *  @param[in] _npc Number of process columns
+   *  @param[in] _map MPI rank of each process coordinate (col-major, npr x npc)
+   */
+  GridSpec( int64_t _npr, int64_t _npc, std::vector<int64_t> _map );
+
+};
+
 /**
  *  \brief A class which provides a C++ wrapper for a BLACS Grid.
  *
@@ -61,6 +124,7 @@ class Grid {
 #endif
 
   Grid( std::shared_ptr<detail::Context> _context );
+  Grid( std::shared_ptr<detail::Context> _context, blacs_grid_dim dim );
 
 public:
 
@@ -169,6 +233,32 @@ public:
     else             return MPI_COMM_NULL;
   }
 
+  /**
+   *  \brief Returns the private communicator used by MPI-backed operations.
+   *
+   *  Duplicate of comm() which is reserved for blacspp's non-BLACS 
+   *  communication so that it cannot match user traffic on comm().
+   *
+   *  @returns Internal MPI communicator for the BLACS grid.
+   */
+  inline MPI_Comm  internal_comm() const noexcept { 
+    if( is_valid() ) return context_->internal_comm; 
+    else             return MPI_COMM_NULL;
+  }
+
+  /**
+   *  \brief Returns the MPI rank of a process coordinate.
+   *
+   *  @param[in] PROW Process row coordinate
+   *  @param[in] PCOL Process column coordinate
+   *  @returns        Rank in comm() (and internal_comm()) of (PROW,PCOL)
+   */
+  inline int64_t comm_rank( int64_t PROW, int64_t PCOL ) const {
+    if( not is_valid() )
+      throw std::runtime_error("Grid::comm_rank called on an invalid grid");
+    return context_->rank_map[ PROW + PCOL * grid_dim_.np_row ];
+  }
+
 
 
 
@@ -180,6 +270,55 @@ public:
   Grid clone() const;
 
 
+  /**
+   *  \brief Create per-thread views of this BLACS grid.
+   *
+   *  Collective over comm(). Each view is a clone of this grid (same process
+   *  coordinates) built on its own duplicate of the MPI communicator, so
+   *  MPI traffic issued on one view can never match traffic issued on another
+   *  or on this grid. Intended to hand one view to each thread of a hybrid
+   *  MPI+threads code.
+   *
+   *  Requires MPI_THREAD_MULTIPLE if more than one view is requested.
+   *
+   *  N.B. Reference BLACS keeps process-global send/recv buffers, so calls
+   *  into BLACS itself must still be serialized by the caller.
+   *
+   *  @param[in] nthreads Number of views to create
+   *  @returns            nthreads independent views of this grid
+   */
+  std::vector<Grid> thread_views( int64_t nthreads ) const;
+
+
+  /**
+   *  \brief Construct a grid of a different shape over the same processes.
+   *
+   *  Collective over comm(). The first new_npr * new_npc processes of this
+   *  grid (in row-major order of their coordinates) form a new_npr x 
+   *  new_npc row-major grid over a communicator of their own. The remaining
+   *  processes recieve an invalid grid. Data distributed over this grid may
+   *  be moved to the new one with RedistributePlan.
+   *
+   *  @param[in] new_npr Number of process rows of the new grid
+   *  @param[in] new_npc Number of process columns of the new grid
+   *  @returns           Reshaped grid (invalid on idle processes)
+   */
+  Grid reshape( int64_t new_npr, int64_t new_npc ) const;
+
+  /**
+   *  \brief Construct a close-to-square grid over a subset of the processes.
+   *
+   *  Collective over comm(). The active processes form a grid (shape as
+   *  square_grid) over a communicator of their own, assigned to coordinates
+   *  row-major in the order given. The remaining processes recieve an 
+   *  invalid grid.
+   *
+   *  @param[in] active_ranks Ranks in comm() of the processes to keep
+   *  @returns                Grid over the active processes (invalid on idle processes)
+   */
+  Grid shrink( const std::vector<int64_t>& active_ranks ) const;
+
+
 
   /**
    *  \brief Constuct a close-to-square BLACS Grid.
@@ -192,6 +331,84 @@ public:
    *  @returns        Square BLACS grid.
    */
   static Grid square_grid( const MPI_Comm& comm, GridOrder order = GridOrder::RowMajor );
+
+  /**
+   *  \brief Wrap an existing BLACS context.
+   *
+   *  Collective over the processes of the BLACS grid. The returned grid
+   *  does not own the context (it is not exited on destruction), so its
+   *  lifetime is left to the caller (e.g. a Fortran ScaLAPACK layer). No new
+   *  BLACS grid is created: the ranks of the grid processes in the system
+   *  communicator of the context (BLACS_GET, WHAT = 10) are exchanged by a
+   *  single combine over the context, and comm() is a new communicator of
+   *  exactly those processes (MPI_Comm_create_group, ordered row-major by
+   *  grid coordinate). Only the grid processes take part.
+   *
+   *  Processes which are not part of the context recieve an invalid grid
+   *  and need not call adopt.
+   *
+   *  @param[in] context BLACS context handle
+   *  @returns           Non-owning grid for the context
+   */
+  static Grid adopt( int64_t context );
+
+  /**
+   *  \brief Construct a BLACS grid from a 2D MPI Cartesian communicator.
+   *
+   *  Process (pr,pc) of the grid is the process with Cartesian coordinates
+   *  (pr,pc), i.e. npr x npc = dims[0] x dims[1]. The communicator is not
+   *  duplicated and must outlive the grid (and its copies).
+   *
+   *  @param[in] cart 2D Cartesian MPI communicator (MPI_COMM_NULL gives an invalid grid)
+   *  @returns        BLACS grid matching the Cartesian topology
+   */
+  static Grid from_cart( MPI_Comm cart );
+
+  /**
+   *  \brief Construct a BLACS grid over a reordered Cartesian communicator.
+   *
+   *  Collective over c. Creates an npr x npc Cartesian communicator with
+   *  MPI_Cart_create( ..., reorder = 1 ), so MPI implementations which know
+   *  the physical network may place grid neighbours close together, and maps
+   *  the BLACS grid onto its coordinates as in from_cart. Unlike 
+   *  Grid( c, npr, npc, order ), the rank order of c is not preserved.
+   *
+   *  The Cartesian communicator is owned by the grid and is returned by
+   *  comm(), so it may be used for MPI neighbour operations. Processes of c
+   *  beyond npr * npc recieve an invalid grid.
+   *
+   *  @param[in] c        MPI Communicator
+   *  @param[in] npr      Number of process rows
+   *  @param[in] npc      Number of process columns
+   *  @param[in] periodic Whether the Cartesian topology is periodic in both dimensions
+   *  @returns            BLACS grid over the Cartesian communicator
+   */
+  static Grid cartesian( MPI_Comm c, int64_t npr, int64_t npc, 
+                         bool periodic = false );
+
+  /**
+   *  \brief Construct several BLACS grids over a communicator at once.
+   *
+   *  Collective over c, every process must pass the same specs. Compared to
+   *  constructing the grids one by one, all grids share a single BLACS
+   *  system handle, the private communicators of all grids are duplicated
+   *  by overlapped nonblocking MPI_Comm_idup, and the consistency of the
+   *  specs is checked by one aggregated reduction. Only the BLACS grid
+   *  creation itself (BLACS_GRIDMAP) remains one collective per grid.
+   *
+   *  The communicator (comm()) of each grid holds only its members, 
+   *  ranked in the (col-major) order of its map, and is created by the 
+   *  members alone (MPI_Comm_create_group).
+   *
+   *  Intended for application startup, e.g. a full grid together with its
+   *  row, column and task-parallel subgrids. Processes which are not part
+   *  of a grid recieve an invalid grid in its place.
+   *
+   *  @param[in] c     MPI Communicator
+   *  @param[in] specs Shapes and process maps (ranks of c) of the grids
+   *  @returns         One grid per spec, in order
+   */
+  static std::vector<Grid> batch( MPI_Comm c, const std::vector<GridSpec>& specs );
 };
 
 }
@@ -0,0 +1,232 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/request.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Rectangular, strided region of a col-major local array.
+ */
+struct HaloRegion {
+  int64_t row; ///< First row of the region
+  int64_t col; ///< First column of the region
+  int64_t m;   ///< Number of rows of the region
+  int64_t n;   ///< Number of columns of the region
+};
+
+/**
+ *  \brief Exchange with a single neighbour of the process grid.
+ *
+ *  The neighbour is the process (ipr + dr, ipc + dc) with dr, dc in 
+ *  {-1, 0, 1}; dr = -1 is north and dc = -1 is west. The send region is
+ *  shipped to that neighbour, which recieves it into its recv region for
+ *  the opposite direction (-dr,-dc).
+ */
+struct HaloNeighbor {
+  int64_t    dr;   ///< Process row offset of the neighbour
+  int64_t    dc;   ///< Process column offset of the neighbour
+  HaloRegion send; ///< Region sent to the neighbour
+  HaloRegion recv; ///< Region recieved from the neighbour
+};
+
+
+/**
+ *  \brief Persistent halo (neighbour) exchange plan on the 2D process grid.
+ *
+ *  Built once from the grid and the per-side regions of a local array, with
+ *  derived MPI datatypes describing the strided regions so that no packing
+ *  is performed. Each exchange posts one non-blocking recieve and send per
+ *  neighbour; start()/finish() allow the interior to be computed while the
+ *  halos are in flight.
+ *
+ *  On non-periodic grids, neighbours beyond the edge of the grid are
+ *  skipped (their recv regions are left untouched).
+ *
+ *  @tparam T Type of the local array. Must be BLACS enabled.
+ */
+template <typename T>
+class HaloExchange {
+
+  static_assert( detail::blacs_supported<T>::value, "T must be BLACS enabled" );
+
+  struct channel {
+    int64_t      rank;  ///< Neighbour rank (MPI_PROC_NULL if none)
+    int64_t      soff;  ///< Offset of the send region
+    int64_t      roff;  ///< Offset of the recv region
+    MPI_Datatype stype; ///< Datatype of the send region
+    MPI_Datatype rtype; ///< Datatype of the recv region
+    internal::mpi_int stag; ///< Tag of outgoing message
+    internal::mpi_int rtag; ///< Tag of incoming message
+  };
+
+  MPI_Comm             comm_;
+  std::vector<channel> channels_;
+  Request              pending_;
+
+  static internal::mpi_int direction_tag( int64_t dr, int64_t dc ) {
+    return internal::mpi_int(detail::Tag::Halo) + (dr+1)*3 + (dc+1);
+  }
+
+public:
+
+  /**
+   *  \brief Construct a halo exchange from arbitrary neighbour regions.
+   *
+   *  @param[in] grid      (local) BLACS grid which defined the communication context.
+   *  @param[in] LDA       (local) Leading dimension of the local array
+   *  @param[in] neighbors (local) Neighbours and their send / recv regions
+   *  @param[in] periodic  (global) Whether the grid wraps around in both dimensions
+   */
+  HaloExchange( const Grid& grid, const int64_t LDA,
+                const std::vector<HaloNeighbor>& neighbors,
+                const bool periodic ) : comm_( grid.internal_comm() ) {
+
+    const auto npr = grid.npr();
+    const auto npc = grid.npc();
+    const auto base = detail::mpi_type<T>::type();
+
+    for( const auto& nb : neighbors ) {
+
+      if( nb.dr < -1 or nb.dr > 1 or nb.dc < -1 or nb.dc > 1 or 
+          (nb.dr == 0 and nb.dc == 0) )
+        throw std::runtime_error("Invalid Halo Neighbor Offset");
+
+      auto pr = grid.ipr() + nb.dr;
+      auto pc = grid.ipc() + nb.dc;
+      int64_t rank = MPI_PROC_NULL;
+      if( periodic ) 
+        rank = grid.comm_rank( (pr + npr) % npr, (pc + npc) % npc );
+      else if( pr >= 0 and pr < npr and pc >= 0 and pc < npc ) 
+        rank = grid.comm_rank( pr, pc );
+
+      channels_.push_back( channel{ rank,
+        nb.send.row + nb.send.col * LDA, nb.recv.row + nb.recv.col * LDA,
+        detail::matrix_type( base, nb.send.m, nb.send.n, LDA ),
+        detail::matrix_type( base, nb.recv.m, nb.recv.n, LDA ),
+        direction_tag(  nb.dr,  nb.dc ), direction_tag( -nb.dr, -nb.dc ) } );
+
+    }
+
+  }
+
+  /**
+   *  \brief Construct a halo exchange for a ghost-cell padded array.
+   *
+   *  The local array is (M + 2*W) x (N + 2*W) (col-major) with the M x N
+   *  interior at (W,W), surrounded by a halo of width W which is filled
+   *  with the adjacent interior rows / columns of the neighbouring processes.
+   *  Process row ipr-1 is north and process column ipc-1 is west.
+   *
+   *  @param[in] grid      (local) BLACS grid which defined the communication context.
+   *  @param[in] M         (local) Number of interior rows
+   *  @param[in] N         (local) Number of interior columns
+   *  @param[in] W         (global) Halo width
+   *  @param[in] LDA       (local) Leading dimension of the local array (>= M + 2*W)
+   *  @param[in] periodic  (global) Whether the grid wraps around in both dimensions
+   *  @param[in] diagonals (global) Whether to also exchange the corner halos
+   */
+  HaloExchange( const Grid& grid, const int64_t M, const int64_t N,
+                const int64_t W, const int64_t LDA, const bool periodic,
+                const bool diagonals = false ) :
+    HaloExchange( grid, LDA, padded_neighbors( M, N, W, diagonals ), periodic ) { }
+
+  HaloExchange( const HaloExchange& ) = delete;
+  HaloExchange& operator=( const HaloExchange& ) = delete;
+
+  ~HaloExchange() noexcept {
+    pending_.wait();
+    for( auto& c : channels_ ) {
+      MPI_Type_free( &c.stype );
+      MPI_Type_free( &c.rtype );
+    }
+  }
+
+  /**
+   *  \brief Neighbours of the ghost-cell padded layout.
+   *
+   *  @param[in] M         Number of interior rows
+   *  @param[in] N         Number of interior columns
+   *  @param[in] W         Halo width
+   *  @param[in] diagonals Whether to include the corner neighbours
+   */
+  static std::vector<HaloNeighbor> padded_neighbors( const int64_t M,
+    const int64_t N, const int64_t W, const bool diagonals ) {
+
+    // Start / extent of the send (interior) and recv (halo) ranges along
+    // one dimension of length L for offset d
+    auto send_range = [&]( int64_t d, int64_t L ) -> std::pair<int64_t,int64_t> {
+      if( d < 0 ) return { W, W };
+      if( d > 0 ) return { L, W };
+      return { W, L };
+    };
+    auto recv_range = [&]( int64_t d, int64_t L ) -> std::pair<int64_t,int64_t> {
+      if( d < 0 ) return { 0, W };
+      if( d > 0 ) return { L + W, W };
+      return { W, L };
+    };
+
+    std::vector<HaloNeighbor> neighbors;
+    for( int64_t dr = -1; dr <= 1; ++dr )
+    for( int64_t dc = -1; dc <= 1; ++dc ) {
+      if( dr == 0 and dc == 0 ) continue;
+      if( dr != 0 and dc != 0 and not diagonals ) continue;
+      auto sr = send_range( dr, M ), sc = send_range( dc, N );
+      auto rr = recv_range( dr, M ), rc = recv_range( dc, N );
+      neighbors.push_back( HaloNeighbor{ dr, dc,
+        HaloRegion{ sr.first, sc.first, sr.second, sc.second },
+        HaloRegion{ rr.first, rc.first, rr.second, rc.second } } );
+    }
+
+    return neighbors;
+
+  }
+
+  /**
+   *  \brief Post the halo exchange.
+   *
+   *  Interior regions which are not sent may be modified, and no region may
+   *  be read or modified otherwise, until finish().
+   *
+   *  @param[in/out] A (local) Pointer to the local array
+   */
+  void start( T* A ) {
+
+    std::vector<MPI_Request> reqs( 2 * channels_.size() );
+    for( size_t i = 0; i < channels_.size(); ++i ) {
+      const auto& c = channels_[i];
+      MPI_Irecv( A + c.roff, 1, c.rtype, c.rank, c.rtag, comm_, &reqs[2*i]   );
+      MPI_Isend( A + c.soff, 1, c.stype, c.rank, c.stag, comm_, &reqs[2*i+1] );
+    }
+    pending_ = Request( std::move(reqs) );
+
+  }
+
+  /**
+   *  \brief Complete the posted halo exchange.
+   */
+  void finish() {
+    pending_.wait();
+    pending_ = Request();
+  }
+
+  /**
+   *  \brief Blocking halo exchange.
+   *
+   *  @param[in/out] A (local) Pointer to the local array
+   */
+  void exchange( T* A ) { start( A ); finish(); }
+
+};
+
+}
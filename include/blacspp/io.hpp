@@ -0,0 +1,180 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/distribution.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace blacspp {
+
+/**
+ *  \brief Description of a matrix file written by write_matrix.
+ *
+ *  On disk a matrix file is a 64 byte header (magic "BLACSPPM", version,
+ *  type, element size, M, N, MB, NB as native 8 byte integers) followed by
+ *  the M x N global matrix in col-major order in native representation.
+ *  The blocking factors record the distribution it was written from and
+ *  do not constrain how it is read back.
+ */
+struct MatrixFileHeader {
+  int64_t M;         ///< Number of global rows
+  int64_t N;         ///< Number of global columns
+  int64_t MB;        ///< Row blocking factor at the time of writing
+  int64_t NB;        ///< Column blocking factor at the time of writing
+  char    type;      ///< BLACS type character ('i', 's', 'd', 'c' or 'z')
+  int64_t elem_size; ///< Size of an element in bytes
+};
+
+/// Size of the on-disk header in bytes
+constexpr int64_t matrix_file_header_bytes = 64;
+
+/**
+ *  \brief Read the header of a matrix file.
+ *
+ *  Collective over comm. The header is read by rank 0 and broadcast.
+ *  Throws if the file cannot be opened or is not a blacspp matrix file.
+ *
+ *  @param[in] comm  MPI communicator
+ *  @param[in] fname Name of the file
+ *  @returns         Header of the file
+ */
+MatrixFileHeader read_matrix_header( MPI_Comm comm, const std::string& fname );
+
+namespace detail {
+
+  /// BLACS type character of a BLACS enabled type
+  template <typename T> struct blacs_type_char;
+  template <> struct blacs_type_char< internal::blacs_int > { static constexpr char value = 'i'; };
+  template <> struct blacs_type_char< float >               { static constexpr char value = 's'; };
+  template <> struct blacs_type_char< double >              { static constexpr char value = 'd'; };
+  template <> struct blacs_type_char< internal::scomplex >  { static constexpr char value = 'c'; };
+  template <> struct blacs_type_char< internal::dcomplex >  { static constexpr char value = 'z'; };
+
+  /**
+   *  \brief Open a matrix file collectively over comm, throws on failure.
+   *
+   *  With write = true the file is created (or truncated) and the header
+   *  is written by rank 0.
+   */
+  MPI_File open_matrix_file( MPI_Comm comm, const std::string& fname, 
+    bool write, const MatrixFileHeader& header );
+
+  /// Read and validate the header of an open matrix file (collective)
+  MatrixFileHeader read_matrix_header( MPI_File fh, MPI_Comm comm, 
+    const std::string& fname );
+
+  /**
+   *  \brief File type selecting the elements of a block-cyclic matrix owned
+   *  by this process (MPI_Type_create_darray, col-major).
+   *
+   *  Caller is responsible for freeing the returned datatype.
+   */
+  MPI_Datatype darray_type( const Grid& grid, const BlockCyclic& d, 
+    MPI_Datatype base );
+
+}
+
+/**
+ *  \brief Write a block-cyclic matrix to a file with collective MPI-IO.
+ *
+ *  Collective over comm() of the grid. Every process writes its own tiles
+ *  directly into their place in the col-major file through an
+ *  MPI_Type_create_darray file view and MPI_File_write_all, so no process
+ *  ever holds more than its local matrix.
+ *
+ *  @tparam T Type of the matrix. Must be BLACS enabled.
+ *
+ *  @param[in] fname (global) Name of the file (created or overwritten)
+ *  @param[in] grid  (local)  BLACS grid over which the matrix is distributed
+ *  @param[in] d     (global) Distribution of the matrix
+ *  @param[in] A     (local)  Local matrix (d.local_rows(grid) x d.local_cols(grid))
+ *  @param[in] LDA   (local)  Leading dimension of A
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  write_matrix( const std::string& fname, const Grid& grid, 
+                const BlockCyclic& d, const T* A, const int64_t LDA ) {
+
+  if( not grid.is_valid() ) return;
+
+  const MatrixFileHeader header = { d.M, d.N, d.MB, d.NB, 
+    detail::blacs_type_char<T>::value, int64_t(sizeof(T)) };
+
+  const auto comm = grid.internal_comm();
+  auto fh = detail::open_matrix_file( comm, fname, true, header );
+
+  const auto base  = detail::mpi_type<T>::type();
+  auto       ftype = detail::darray_type( grid, d, base );
+  auto       mtype = detail::matrix_type( base, d.local_rows( grid ), 
+                                          d.local_cols( grid ), LDA );
+
+  char datarep[] = "native";
+  MPI_File_set_view( fh, matrix_file_header_bytes, base, ftype, datarep, 
+                     MPI_INFO_NULL );
+  MPI_File_write_all( fh, A, 1, mtype, MPI_STATUS_IGNORE );
+
+  MPI_Type_free( &ftype );
+  MPI_Type_free( &mtype );
+  MPI_File_close( &fh );
+
+}
+
+/**
+ *  \brief Read a block-cyclic matrix from a file with collective MPI-IO.
+ *
+ *  Collective over comm() of the grid. The file may have been written from
+ *  any grid shape and distribution, only its dimensions and type must
+ *  match (throws otherwise, on every process).
+ *
+ *  @tparam T Type of the matrix. Must be BLACS enabled.
+ *
+ *  @param[in]  fname (global) Name of the file
+ *  @param[in]  grid  (local)  BLACS grid over which the matrix is distributed
+ *  @param[in]  d     (global) Distribution of the matrix
+ *  @param[out] A     (local)  Local matrix (d.local_rows(grid) x d.local_cols(grid))
+ *  @param[in]  LDA   (local)  Leading dimension of A
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  read_matrix( const std::string& fname, const Grid& grid, 
+               const BlockCyclic& d, T* A, const int64_t LDA ) {
+
+  if( not grid.is_valid() ) return;
+
+  const auto comm = grid.internal_comm();
+  auto fh = detail::open_matrix_file( comm, fname, false, MatrixFileHeader() );
+
+  const auto header = detail::read_matrix_header( fh, comm, fname );
+  if( header.M != d.M or header.N != d.N or 
+      header.type != detail::blacs_type_char<T>::value or
+      header.elem_size != int64_t(sizeof(T)) ) {
+    MPI_File_close( &fh );
+    throw std::runtime_error(fname + " does not hold a matrix of the requested type and dimensions");
+  }
+
+  const auto base  = detail::mpi_type<T>::type();
+  auto       ftype = detail::darray_type( grid, d, base );
+  auto       mtype = detail::matrix_type( base, d.local_rows( grid ), 
+                                          d.local_cols( grid ), LDA );
+
+  char datarep[] = "native";
+  MPI_File_set_view( fh, matrix_file_header_bytes, base, ftype, datarep, 
+                     MPI_INFO_NULL );
+  MPI_File_read_all( fh, A, 1, mtype, MPI_STATUS_IGNORE );
+
+  MPI_Type_free( &ftype );
+  MPI_Type_free( &mtype );
+  MPI_File_close( &fh );
+
+}
+
+}
@@ -0,0 +1,160 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Communication plan for a distributed row interchange (LASWP).
+ *
+ *  Rows of a matrix are distributed block-cyclically (block size MB, first
+ *  block on process row RSRC) over the rows of the process grid. The plan
+ *  composes the sequence of interchanges described by a pivot vector into
+ *  a single permutation once, and records for each partner process row of
+ *  the same process column which local rows are sent and recieved. Each
+ *  execution then exchanges one aggregated message per partner in a single
+ *  non-blocking phase, rather than a serialized send/recieve per swap.
+ *
+ *  The plan depends only on the row distribution and the pivots, so it may
+ *  be applied to any number of column panels (e.g. to the left and right of
+ *  an LU panel).
+ */
+class RowSwapPlan {
+
+  Grid                                grid_;      ///< Grid of the distribution
+  std::vector< std::vector<int64_t> > send_rows_; ///< Local rows to send, per process row
+  std::vector< std::vector<int64_t> > recv_rows_; ///< Local rows to recieve, per process row
+  std::vector< int64_t >              local_src_; ///< Local rows moved within this process
+  std::vector< int64_t >              local_dst_; ///< Destinations of local_src_
+
+public:
+
+  /**
+   *  \brief Construct a row interchange plan.
+   *
+   *  Row K of the global matrix is interchanged with row IPIV[K-K1] for
+   *  K = K1, ..., K2-1, in order (0-based global indices, as LAPACK's LASWP
+   *  with INCX = 1).
+   *
+   *  @param[in] grid (local)  BLACS grid over which the rows are distributed
+   *  @param[in] MB   (global) Row blocking factor of the distribution
+   *  @param[in] RSRC (global) Process row owning the first row block
+   *  @param[in] K1   (global) First pivot row
+   *  @param[in] K2   (global) One past the last pivot row
+   *  @param[in] IPIV (global) Pivot indices (length K2-K1)
+   */
+  RowSwapPlan( const Grid& grid, const int64_t MB, const int64_t RSRC,
+               const int64_t K1, const int64_t K2, const int64_t* IPIV );
+
+  /**
+   *  \brief Apply the row interchange to a local column panel.
+   *
+   *  Every process of a process column must call execute with the same N.
+   *
+   *  @tparam T Type of the matrix. Must be BLACS enabled.
+   *
+   *  @param[in]     N   (local) Number of local columns to permute
+   *  @param[in/out] A   (local) Pointer to the local rows of the matrix
+   *  @param[in]     LDA (local) Leading dimension of A
+   */
+  template <typename T>
+  detail::enable_if_blacs_supported_t<T>
+    execute( const int64_t N, T* A, const int64_t LDA ) const;
+
+  /// Number of local rows sent to other processes
+  int64_t send_count() const noexcept;
+
+  /// Number of partner processes exchanged with
+  int64_t partner_count() const noexcept;
+
+};
+
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  RowSwapPlan::execute( const int64_t N, T* A, const int64_t LDA ) const {
+
+  const auto npr   = grid_.npr();
+  const auto comm  = grid_.internal_comm();
+  const auto dtype = detail::mpi_type<T>::type();
+  const auto tag   = internal::mpi_int(detail::Tag::RowSwap);
+
+  auto pack = [&]( const std::vector<int64_t>& rows, T* buf ) {
+    for( int64_t j = 0; j < N; ++j )
+    for( size_t  k = 0; k < rows.size(); ++k )
+      buf[k + j*rows.size()] = A[rows[k] + j*LDA];
+  };
+  auto unpack = [&]( const std::vector<int64_t>& rows, const T* buf ) {
+    for( int64_t j = 0; j < N; ++j )
+    for( size_t  k = 0; k < rows.size(); ++k )
+      A[rows[k] + j*LDA] = buf[k + j*rows.size()];
+  };
+
+  std::vector< std::vector<T> > sbuf( npr ), rbuf( npr );
+  std::vector< MPI_Request >    reqs;
+
+  for( int64_t p = 0; p < npr; ++p ) if( recv_rows_[p].size() ) {
+    rbuf[p].resize( recv_rows_[p].size() * N );
+    reqs.emplace_back();
+    MPI_Irecv( rbuf[p].data(), rbuf[p].size(), dtype,
+               grid_.comm_rank( p, grid_.ipc() ), tag, comm, &reqs.back() );
+  }
+
+  // Pack every outgoing row (and locally moved row) before any is overwritten
+  for( int64_t p = 0; p < npr; ++p ) if( send_rows_[p].size() ) {
+    sbuf[p].resize( send_rows_[p].size() * N );
+    pack( send_rows_[p], sbuf[p].data() );
+    reqs.emplace_back();
+    MPI_Isend( sbuf[p].data(), sbuf[p].size(), dtype,
+               grid_.comm_rank( p, grid_.ipc() ), tag, comm, &reqs.back() );
+  }
+
+  std::vector<T> lbuf( local_src_.size() * N );
+  pack( local_src_, lbuf.data() );
+  unpack( local_dst_, lbuf.data() );
+
+  MPI_Waitall( reqs.size(), reqs.data(), MPI_STATUSES_IGNORE );
+
+  for( int64_t p = 0; p < npr; ++p ) if( recv_rows_[p].size() )
+    unpack( recv_rows_[p], rbuf[p].data() );
+
+}
+
+
+/**
+ *  \brief Distributed row interchange over a process column (LASWP).
+ *
+ *  Convenience wrapper which builds a RowSwapPlan and executes it once.
+ *
+ *  @tparam T Type of the matrix. Must be BLACS enabled.
+ *
+ *  @param[in]     grid (local)  BLACS grid over which the rows are distributed
+ *  @param[in]     N    (local)  Number of local columns to permute
+ *  @param[in/out] A    (local)  Pointer to the local rows of the matrix
+ *  @param[in]     LDA  (local)  Leading dimension of A
+ *  @param[in]     MB   (global) Row blocking factor of the distribution
+ *  @param[in]     RSRC (global) Process row owning the first row block
+ *  @param[in]     K1   (global) First pivot row
+ *  @param[in]     K2   (global) One past the last pivot row
+ *  @param[in]     IPIV (global) Pivot indices (length K2-K1)
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  laswp2d( const Grid& grid, const int64_t N, T* A, const int64_t LDA,
+           const int64_t MB, const int64_t RSRC, const int64_t K1,
+           const int64_t K2, const int64_t* IPIV ) {
+
+  RowSwapPlan( grid, MB, RSRC, K1, K2, IPIV ).execute( N, A, LDA );
+
+}
+
+}
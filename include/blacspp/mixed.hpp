@@ -0,0 +1,195 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/packed.hpp>
+#include <blacspp/util/half.hpp>
+#include <blacspp/util/scope.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace blacspp {
+
+namespace detail {
+
+  template <typename From, typename To, typename U = void>
+  using enable_if_convertible_t = 
+    enable_if_t< std::is_constructible<To,From>::value, U >;
+
+  /**
+   *  \brief Pack a col-major M x N buffer while converting its elements.
+   *
+   *  Conversion is fused with packing: a single pass over unit-stride
+   *  columns, which the compiler vectorizes for the standard types (and for
+   *  the branch-free bfloat16 rounding).
+   */
+  template <typename To, typename From>
+  void convert_pack( const int64_t M, const int64_t N, const From* A,
+    const int64_t LDA, To* buf ) {
+
+    for( int64_t j = 0; j < N; ++j ) {
+      const From* a = A   + j*LDA;
+      To*         b = buf + j*M;
+      for( int64_t i = 0; i < M; ++i ) b[i] = static_cast<To>( a[i] );
+    }
+
+  }
+
+  /**
+   *  \brief Unpack a contiguous buffer into a col-major M x N buffer
+   *  while converting its elements.
+   */
+  template <typename From, typename To>
+  void convert_unpack( const int64_t M, const int64_t N, const From* buf,
+    To* A, const int64_t LDA ) {
+
+    for( int64_t j = 0; j < N; ++j ) {
+      const From* b = buf + j*M;
+      To*         a = A   + j*LDA;
+      for( int64_t i = 0; i < M; ++i ) a[i] = static_cast<To>( b[i] );
+    }
+
+  }
+
+}
+
+/**
+ *  \brief Mixed-precision point-to-point 2D send.
+ *
+ *  Sends an M x N buffer of type T with elements converted to Wire on the
+ *  wire (e.g. double as float, bfloat16 or float16, each rounded once to
+ *  nearest even). Must be matched by
+ *  gerv2d_as with the same Wire type, which may recieve into a different
+ *  type than T.
+ *
+ *  @tparam Wire Element type on the wire. T must be convertible to Wire.
+ *  @tparam T    Type of buffer to send.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename Wire, typename T>
+detail::enable_if_convertible_t<T,Wire>
+  gesd2d_as( const Grid& grid, const int64_t M, const int64_t N,
+             const T* A, const int64_t LDA,
+             const int64_t RDEST, const int64_t CDEST ) {
+
+  auto buf = detail::pack_scratch<Wire>( M*N );
+  detail::convert_pack( M, N, A, LDA, buf );
+  MPI_Send( buf, M*N*sizeof(Wire), MPI_BYTE, grid.comm_rank( RDEST, CDEST ),
+            internal::mpi_int(detail::Tag::Mixed), grid.internal_comm() );
+
+}
+
+/**
+ *  \brief Mixed-precision point-to-point 2D recieve.
+ *
+ *  Recieves an M x N buffer sent by gesd2d_as with the same Wire type,
+ *  converting its elements to T.
+ *
+ *  @tparam Wire Element type on the wire. Wire must be convertible to T.
+ *  @tparam T    Type of buffer to recieve into.
+ *
+ *  @param[in]  grid (local) BLACS grid which defined the communication context.
+ *  @param[in]  M    (local) Number of rows of the buffer to recieve
+ *  @param[in]  N    (local) Number of columns of the buffer to recieve
+ *  @param[out] A    (local) Pointer of buffer to recieve into
+ *  @param[in]  LDA  (local) Leading dimension of the buffer to recieve
+ *  @param[in]  RSRC (local) Process row coordinate of source process
+ *  @param[in]  CSRC (local) Process column coordinate of source process
+ *
+ */
+template <typename Wire, typename T>
+detail::enable_if_convertible_t<Wire,T>
+  gerv2d_as( const Grid& grid, const int64_t M, const int64_t N,
+             T* A, const int64_t LDA,
+             const int64_t RSRC, const int64_t CSRC ) {
+
+  auto buf = detail::pack_scratch<Wire>( M*N );
+  MPI_Recv( buf, M*N*sizeof(Wire), MPI_BYTE, grid.comm_rank( RSRC, CSRC ),
+            internal::mpi_int(detail::Tag::Mixed), grid.internal_comm(),
+            MPI_STATUS_IGNORE );
+  detail::convert_unpack( M, N, buf, A, LDA );
+
+}
+
+/**
+ *  \brief Mixed-precision 2D broadcast send.
+ *
+ *  Broadcasts an M x N buffer of type T over a scope with elements
+ *  converted to Wire on the wire. Must be matched by gebr2d_as with the
+ *  same Wire type on the other participants of the scope.
+ *
+ *  @tparam Wire Element type on the wire. T must be convertible to Wire.
+ *  @tparam T    Type of buffer to send.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *
+ */
+template <typename Wire, typename T>
+detail::enable_if_convertible_t<T,Wire>
+  gebs2d_as( const Grid& grid, const Scope scope, const int64_t M,
+             const int64_t N, const T* A, const int64_t LDA ) {
+
+  detail::scope_members members( grid, scope );
+  auto buf = detail::pack_scratch<Wire>( M*N );
+  detail::convert_pack( M, N, A, LDA, buf );
+
+  std::vector<MPI_Request> reqs( members.size() - 1 );
+  for( int64_t i = 1; i < members.size(); ++i )
+    MPI_Isend( buf, M*N*sizeof(Wire), MPI_BYTE, members.shifted( i ),
+               internal::mpi_int(detail::Tag::MixedBroadcast),
+               grid.internal_comm(), &reqs[i-1] );
+  MPI_Waitall( reqs.size(), reqs.data(), MPI_STATUSES_IGNORE );
+
+}
+
+/**
+ *  \brief Mixed-precision 2D broadcast recieve.
+ *
+ *  @tparam Wire Element type on the wire. Wire must be convertible to T.
+ *  @tparam T    Type of buffer to recieve into.
+ *
+ *  @param[in]  grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]  scope (local) Scope of the broadcast
+ *  @param[in]  M     (local) Number of rows of the buffer to recieve
+ *  @param[in]  N     (local) Number of columns of the buffer to recieve
+ *  @param[out] A     (local) Pointer of buffer to recieve into
+ *  @param[in]  LDA   (local) Leading dimension of the buffer to recieve
+ *  @param[in]  RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]  CSRC  (local) Process column coordinate of the broadcast root
+ *
+ */
+template <typename Wire, typename T>
+detail::enable_if_convertible_t<Wire,T>
+  gebr2d_as( const Grid& grid, const Scope scope, const int64_t M,
+             const int64_t N, T* A, const int64_t LDA,
+             const int64_t RSRC, const int64_t CSRC ) {
+
+  if( not detail::in_scope( grid, scope, RSRC, CSRC ) )
+    throw std::runtime_error("gebr2d_as: broadcast root is not in the scope");
+
+  auto buf = detail::pack_scratch<Wire>( M*N );
+  MPI_Recv( buf, M*N*sizeof(Wire), MPI_BYTE, grid.comm_rank( RSRC, CSRC ),
+            internal::mpi_int(detail::Tag::MixedBroadcast), grid.internal_comm(),
+            MPI_STATUS_IGNORE );
+  detail::convert_unpack( M, N, buf, A, LDA );
+
+}
+
+}
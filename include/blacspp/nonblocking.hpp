@@ -0,0 +1,282 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/request.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <stdexcept>
+
+namespace blacspp {
+
+
+/**
+ *  \brief Non-blocking general point-to-point 2D send.
+ *
+ *  Posts a general (rectangular) point-to-point 2D send on a BLACS grid and
+ *  returns immediately. The buffer may not be modified until the returned
+ *  request has completed. Messages are carried by MPI on Grid::internal_comm()
+ *  and therefore only match igerv2d (not BLACS gerv2d).
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *
+ *  @returns Request handle for the posted send
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  igesd2d( const Grid& grid,
+           const int64_t M, const int64_t N, const T* A, const int64_t LDA,
+           const int64_t RDEST, const int64_t CDEST ) {
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  MPI_Request req;
+  MPI_Isend( A, 1, dtype, grid.comm_rank( RDEST, CDEST ),
+             internal::mpi_int(detail::Tag::PointToPoint),
+             grid.internal_comm(), &req );
+
+  MPI_Type_free( &dtype );
+  return Request( { req } );
+
+}
+
+/**
+ *  \brief Non-blocking general point-to-point 2D send.
+ *
+ *  Sends a buffer which is managed by a C++ container. Size of buffer deduced
+ *  from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] A     (local) Buffer to send (managed by some container)
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *
+ *  @returns Request handle for the posted send
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, Request >
+  igesd2d( const Grid& grid, const Container& A,
+           const int64_t RDEST, const int64_t CDEST ) {
+
+  return igesd2d( grid, A.size(), 1, A.data(), A.size(), RDEST, CDEST );
+
+}
+
+
+
+
+
+/**
+ *  \brief Non-blocking general point-to-point 2D recieve.
+ *
+ *  Posts a general (rectangular) point-to-point 2D recieve on a BLACS grid and
+ *  returns immediately. The buffer contents are undefined until the returned
+ *  request has completed.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *
+ *  @returns Request handle for the posted recieve
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  igerv2d( const Grid& grid, const int64_t M, const int64_t N,
+           T* A, const int64_t LDA, const int64_t RSRC,
+           const int64_t CSRC ) {
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  MPI_Request req;
+  MPI_Irecv( A, 1, dtype, grid.comm_rank( RSRC, CSRC ),
+             internal::mpi_int(detail::Tag::PointToPoint),
+             grid.internal_comm(), &req );
+
+  MPI_Type_free( &dtype );
+  return Request( { req } );
+
+}
+
+/**
+ *  \brief Non-blocking general point-to-point 2D recieve.
+ *
+ *  Recieve buffer managed by C++ container. Size of buffer deduced from
+ *  Container::size()
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *
+ *  @returns Request handle for the posted recieve
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, Request >
+  igerv2d( const Grid& grid, Container& A,
+           const int64_t RSRC, const int64_t CSRC ) {
+
+  return igerv2d( grid, A.size(), 1, A.data(), A.size(), RSRC, CSRC );
+
+}
+
+
+
+
+
+
+/**
+ *  \brief Non-blocking general 2D broadcast send.
+ *
+ *  Posts the root side of a general (rectangular) 2D broadcast over the
+ *  specified scope and returns immediately. Must be matched by igebr2d on
+ *  every other process of the scope.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *
+ *  @returns Request handle for the posted broadcast
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  igebs2d( const Grid& grid, const Scope scope,
+           const int64_t M, const int64_t N, const T* A, const int64_t LDA ) {
+
+  detail::scope_members members( grid, scope );
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  std::vector<MPI_Request> reqs( members.size() - 1 );
+  for( int64_t i = 1; i < members.size(); ++i )
+    MPI_Isend( A, 1, dtype, members.shifted( i ),
+               internal::mpi_int(detail::Tag::Broadcast),
+               grid.internal_comm(), &reqs[i-1] );
+
+  MPI_Type_free( &dtype );
+  return Request( std::move(reqs) );
+
+}
+
+/**
+ *  \brief Non-blocking general 2D broadcast send.
+ *
+ *  Sends a buffer which is managed by a C++ container. Size of buffer deduced
+ *  from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] A     (local) Buffer to send (managed by some container)
+ *
+ *  @returns Request handle for the posted broadcast
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, Request >
+  igebs2d( const Grid& grid, const Scope scope, const Container& A ) {
+
+  return igebs2d( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Non-blocking general 2D broadcast recieve.
+ *
+ *  Posts the recieving side of a general (rectangular) 2D broadcast over the
+ *  specified scope and returns immediately.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the broadcast
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
+ *
+ *  @returns Request handle for the posted recieve
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  igebr2d( const Grid& grid, const Scope scope,
+           const int64_t M, const int64_t N, T* A, const int64_t LDA,
+           const int64_t RSRC, const int64_t CSRC ) {
+
+  if( not detail::in_scope( grid, scope, RSRC, CSRC ) )
+    throw std::runtime_error("igebr2d: broadcast root is not in the scope");
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  MPI_Request req;
+  MPI_Irecv( A, 1, dtype, grid.comm_rank( RSRC, CSRC ),
+             internal::mpi_int(detail::Tag::Broadcast),
+             grid.internal_comm(), &req );
+
+  MPI_Type_free( &dtype );
+  return Request( { req } );
+
+}
+
+/**
+ *  \brief Non-blocking general 2D broadcast recieve.
+ *
+ *  Recieve buffer managed by C++ container. Size of buffer deduced from
+ *  Container::size()
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the broadcast
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
+ *
+ *  @returns Request handle for the posted recieve
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, Request >
+  igebr2d( const Grid& grid, const Scope scope, Container& A,
+           const int64_t RSRC, const int64_t CSRC ) {
+
+  return igebr2d( grid, scope, A.size(), 1, A.data(), A.size(), RSRC, CSRC );
+
+}
+
+}
@@ -0,0 +1,233 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/nonblocking.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+namespace detail {
+
+  /**
+   *  \brief Row range [first, last) of column j of a BLACS trapezoid.
+   *
+   *  Follows the trsd2d conventions: for Uplo::Upper with M > N the first
+   *  M-N rows are rectangular and the last N rows upper triangular, for
+   *  Uplo::Lower with N > M the first N-M columns are rectangular and the
+   *  last M columns lower triangular. With Diag::Unit the diagonal of the
+   *  triangular part is not referenced.
+   */
+  inline std::pair<int64_t,int64_t> trapezoid_rows( const Uplo uplo, 
+    const Diag diag, const int64_t M, const int64_t N, const int64_t j ) {
+
+    const int64_t unit = diag == Diag::Unit;
+    if( uplo == Uplo::Upper ) {
+      const auto d = std::max<int64_t>( M - N, 0 );
+      return { 0, std::min( M, j + d + 1 - unit ) };
+    } else {
+      const auto d = std::max<int64_t>( N - M, 0 );
+      return { j < d ? 0 : std::min( M, j - d + unit ), M };
+    }
+
+  }
+
+  /**
+   *  \brief Number of elements of a packed BLACS trapezoid.
+   */
+  inline int64_t trapezoid_size( const Uplo uplo, const Diag diag,
+    const int64_t M, const int64_t N ) {
+
+    int64_t n = 0;
+    for( int64_t j = 0; j < N; ++j ) {
+      const auto r = trapezoid_rows( uplo, diag, M, N, j );
+      n += std::max<int64_t>( r.second - r.first, 0 );
+    }
+    return n;
+
+  }
+
+  /**
+   *  \brief Pack a BLACS trapezoid into contiguous storage (column by column).
+   *
+   *  Each column of the trapezoid is a unit-stride segment on both sides,
+   *  so the copy reduces to one (vectorized) block copy per column.
+   */
+  template <typename T>
+  void trapezoid_pack( const Uplo uplo, const Diag diag, const int64_t M,
+    const int64_t N, const T* A, const int64_t LDA, T* buf ) {
+
+    for( int64_t j = 0; j < N; ++j ) {
+      const auto r = trapezoid_rows( uplo, diag, M, N, j );
+      if( r.second > r.first ) 
+        buf = std::copy( A + r.first + j*LDA, A + r.second + j*LDA, buf );
+    }
+
+  }
+
+  /**
+   *  \brief Unpack a contiguous BLACS trapezoid (inverse of trapezoid_pack).
+   */
+  template <typename T>
+  void trapezoid_unpack( const Uplo uplo, const Diag diag, const int64_t M,
+    const int64_t N, const T* buf, T* A, const int64_t LDA ) {
+
+    for( int64_t j = 0; j < N; ++j ) {
+      const auto r = trapezoid_rows( uplo, diag, M, N, j );
+      if( r.second > r.first ) {
+        std::copy_n( buf, r.second - r.first, A + r.first + j*LDA );
+        buf += r.second - r.first;
+      }
+    }
+
+  }
+
+  /**
+   *  \brief Per-thread packing scratch buffer, reused across calls.
+   *
+   *  @param[in] n Minimum number of elements
+   *  @returns     Pointer to at least n elements of scratch storage
+   */
+  template <typename T>
+  T* pack_scratch( const int64_t n ) {
+    static thread_local std::vector<T> scratch;
+    if( int64_t(scratch.size()) < n ) scratch.resize( n );
+    return scratch.data();
+  }
+
+}
+
+/**
+ *  \brief Packed triangular point-to-point 2D send.
+ *
+ *  Same semantics as trsd2d, but only the referenced trapezoid is sent
+ *  (about half the bytes of the full M x N buffer for a square triangle),
+ *  packed contiguously into a reused per-thread scratch buffer. Must be
+ *  matched by trrv2d_packed.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] uplo  (local) Which triangle of the buffer to send (upper/lower)
+ *  @param[in] diag  (local) Whether to imply that the diagonal of the buffer is unit.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  trsd2d_packed( const Grid& grid, const Uplo uplo, const Diag diag,
+                 const int64_t M, const int64_t N, const T* A, const int64_t LDA,
+                 const int64_t RDEST, const int64_t CDEST ) {
+
+  const auto n = detail::trapezoid_size( uplo, diag, M, N );
+  auto buf = detail::pack_scratch<T>( n );
+  detail::trapezoid_pack( uplo, diag, M, N, A, LDA, buf );
+  igesd2d( grid, n, 1, buf, n, RDEST, CDEST ).wait();
+
+}
+
+/**
+ *  \brief Packed triangular point-to-point 2D recieve.
+ *
+ *  Recieves a trapezoid sent by trsd2d_packed; elements of A outside of
+ *  the trapezoid are not modified.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     uplo  (local) Which triangle of the buffer to recieve (upper/lower)
+ *  @param[in]     diag  (local) Whether to imply that the diagonal of the buffer is unit.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to recieve into
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to recieve
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  trrv2d_packed( const Grid& grid, const Uplo uplo, const Diag diag,
+                 const int64_t M, const int64_t N, T* A, const int64_t LDA,
+                 const int64_t RSRC, const int64_t CSRC ) {
+
+  const auto n = detail::trapezoid_size( uplo, diag, M, N );
+  auto buf = detail::pack_scratch<T>( n );
+  igerv2d( grid, n, 1, buf, n, RSRC, CSRC ).wait();
+  detail::trapezoid_unpack( uplo, diag, M, N, buf, A, LDA );
+
+}
+
+/**
+ *  \brief Packed triangular 2D broadcast send.
+ *
+ *  Same semantics as trbs2d, sending only the packed trapezoid. Must be
+ *  matched by trbr2d_packed on the other participants of the scope.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] uplo  (local) Which triangle of the buffer to send (upper/lower)
+ *  @param[in] diag  (local) Whether to imply that the diagonal of the buffer is unit.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  trbs2d_packed( const Grid& grid, const Scope scope, const Uplo uplo,
+                 const Diag diag, const int64_t M, const int64_t N, 
+                 const T* A, const int64_t LDA ) {
+
+  const auto n = detail::trapezoid_size( uplo, diag, M, N );
+  auto buf = detail::pack_scratch<T>( n );
+  detail::trapezoid_pack( uplo, diag, M, N, A, LDA, buf );
+  igebs2d( grid, scope, n, 1, buf, n ).wait();
+
+}
+
+/**
+ *  \brief Packed triangular 2D broadcast recieve.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the broadcast
+ *  @param[in]     uplo  (local) Which triangle of the buffer to recieve (upper/lower)
+ *  @param[in]     diag  (local) Whether to imply that the diagonal of the buffer is unit.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to recieve into
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to recieve
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcast root
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  trbr2d_packed( const Grid& grid, const Scope scope, const Uplo uplo,
+                 const Diag diag, const int64_t M, const int64_t N, 
+                 T* A, const int64_t LDA, const int64_t RSRC, 
+                 const int64_t CSRC ) {
+
+  const auto n = detail::trapezoid_size( uplo, diag, M, N );
+  auto buf = detail::pack_scratch<T>( n );
+  igebr2d( grid, scope, n, 1, buf, n, RSRC, CSRC ).wait();
+  detail::trapezoid_unpack( uplo, diag, M, N, buf, A, LDA );
+
+}
+
+}
@@ -0,0 +1,488 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Handle to a persistent (repeatable) blacspp operation.
+ *
+ *  Created once by one of the *_init functions, which perform all setup
+ *  (partner lookup, datatype construction, MPI request initialization), and
+ *  then started repeatedly. Each repetition costs only start() and wait().
+ *
+ *  An operation consists of one or more rounds of persistent MPI requests,
+ *  with local work (e.g. packing or combining) before / after each round.
+ *  Single round operations map directly onto MPI_Startall / MPI_Waitall.
+ *
+ *  The buffers given at initialization are used by every repetition and
+ *  must remain valid for the lifetime of the PersistentRequest.
+ */
+class PersistentRequest {
+
+public:
+
+  struct round {
+    std::vector<MPI_Request> handles; ///< Persistent MPI requests
+    std::function<void()>    before;  ///< Local work before the round (may be empty)
+    std::function<void()>    after;   ///< Local work after the round (may be empty)
+  };
+
+private:
+
+  std::vector<round>        rounds_;
+  std::vector<MPI_Datatype> types_;   ///< Datatypes referenced by the requests
+  MPI_Comm                  comm_;    ///< Owned communicator (if any)
+  size_t                    current_; ///< Current round when active
+  bool                      active_;  ///< Whether the operation is in flight
+
+  void start_round();
+  void release() noexcept;
+
+public:
+
+  /**
+   *  \brief Construct an empty (trivially complete) persistent request.
+   */
+  PersistentRequest() noexcept;
+
+  /**
+   *  \brief Construct a persistent request from initialized rounds.
+   *
+   *  Takes ownership of the MPI requests, datatypes and communicator.
+   *
+   *  @param[in] rounds Rounds of the operation
+   *  @param[in] types  Datatypes to be freed with the request
+   *  @param[in] comm   Communicator to be freed with the request (or MPI_COMM_NULL)
+   */
+  PersistentRequest( std::vector<round> rounds, std::vector<MPI_Datatype> types,
+                     MPI_Comm comm = MPI_COMM_NULL );
+
+  PersistentRequest( PersistentRequest&& other ) noexcept;
+  PersistentRequest& operator=( PersistentRequest&& other ) noexcept;
+
+  PersistentRequest( const PersistentRequest& ) = delete;
+  PersistentRequest& operator=( const PersistentRequest& ) = delete;
+
+  ~PersistentRequest() noexcept;
+
+  /**
+   *  \brief Start an instance of the operation.
+   *
+   *  Throws if the previous instance has not completed.
+   */
+  void start();
+
+  /**
+   *  \brief Check (without blocking) whether the started instance has
+   *  completed, progressing to subsequent rounds as needed.
+   *
+   *  @returns Whether the operation is complete (true if not started)
+   */
+  bool test();
+
+  /**
+   *  \brief Block until the started instance has completed.
+   */
+  void wait();
+
+  /// Whether an instance is in flight
+  inline bool active() const noexcept { return active_; }
+
+};
+
+namespace detail {
+
+  /**
+   *  \brief Communicator over the participants of a scope, in scope order.
+   *
+   *  Collective only over the participants (MPI_Comm_create_group).
+   */
+  inline MPI_Comm scope_comm( const Grid& grid, const scope_members& members ) {
+
+    MPI_Group world, group;
+    MPI_Comm_group( grid.internal_comm(), &world );
+    std::vector<internal::mpi_int> ranks( members.ranks.begin(), members.ranks.end() );
+    MPI_Group_incl( world, ranks.size(), ranks.data(), &group );
+
+    MPI_Comm comm;
+    MPI_Comm_create_group( grid.internal_comm(), group, 
+                           internal::mpi_int(Tag::Broadcast), &comm );
+
+    MPI_Group_free( &group );
+    MPI_Group_free( &world );
+    return comm;
+
+  }
+
+}
+
+
+/**
+ *  \brief Persistent general point-to-point 2D send.
+ *
+ *  Same arguments as gesd2d; matches any recieve of igerv2d / gerv2d_init.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer
+ *  @param[in] N     (local) Number of columns of the buffer
+ *  @param[in] A     (local) Pointer of the buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer
+ *  @param[in] RDEST (local) Process row coordinate of destination
+ *  @param[in] CDEST (local) Process column coordinate of destination
+ *
+ *  @returns Persistent request for the send
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, PersistentRequest >
+  gesd2d_init( const Grid& grid,
+               const int64_t M, const int64_t N, const T* A, const int64_t LDA,
+               const int64_t RDEST, const int64_t CDEST ) {
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  PersistentRequest::round r;
+  r.handles.resize(1);
+  MPI_Send_init( A, 1, dtype, grid.comm_rank( RDEST, CDEST ),
+                 internal::mpi_int(detail::Tag::PointToPoint),
+                 grid.internal_comm(), &r.handles[0] );
+
+  return PersistentRequest( { std::move(r) }, { dtype } );
+
+}
+
+/**
+ *  \brief Persistent general point-to-point 2D recieve.
+ *
+ *  Same arguments as gerv2d; matches any send of igesd2d / gesd2d_init.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]  grid (local) BLACS grid which defined the communication context.
+ *  @param[in]  M    (local) Number of rows of the buffer
+ *  @param[in]  N    (local) Number of columns of the buffer
+ *  @param[out] A    (local) Pointer of the buffer to recieve into
+ *  @param[in]  LDA  (local) Leading dimension of the buffer
+ *  @param[in]  RSRC (local) Process row coordinate of source
+ *  @param[in]  CSRC (local) Process column coordinate of source
+ *
+ *  @returns Persistent request for the recieve
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, PersistentRequest >
+  gerv2d_init( const Grid& grid,
+               const int64_t M, const int64_t N, T* A, const int64_t LDA,
+               const int64_t RSRC, const int64_t CSRC ) {
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  PersistentRequest::round r;
+  r.handles.resize(1);
+  MPI_Recv_init( A, 1, dtype, grid.comm_rank( RSRC, CSRC ),
+                 internal::mpi_int(detail::Tag::PointToPoint),
+                 grid.internal_comm(), &r.handles[0] );
+
+  return PersistentRequest( { std::move(r) }, { dtype } );
+
+}
+
+/**
+ *  \brief Persistent general 2D broadcast send.
+ *
+ *  Same arguments as gebs2d. With MPI-4 this is an MPI_Bcast_init over the
+ *  scope, which must be matched by gebr2d_init on every other participant.
+ *  Otherwise it is a set of persistent sends to the other participants.
+ *  Initialization is collective over the scope.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Scope of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer
+ *  @param[in] N     (local) Number of columns of the buffer
+ *  @param[in] A     (local) Pointer of the buffer to broadcast
+ *  @param[in] LDA   (local) Leading dimension of the buffer
+ *
+ *  @returns Persistent request for the broadcast
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, PersistentRequest >
+  gebs2d_init( const Grid& grid, const Scope scope,
+               const int64_t M, const int64_t N, const T* A, const int64_t LDA ) {
+
+  detail::scope_members members( grid, scope );
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  PersistentRequest::round r;
+
+#if MPI_VERSION >= 4
+  auto comm = detail::scope_comm( grid, members );
+  r.handles.resize(1);
+  MPI_Bcast_init( const_cast<T*>(A), 1, dtype, members.me, comm, MPI_INFO_NULL,
+                  &r.handles[0] );
+  return PersistentRequest( { std::move(r) }, { dtype }, comm );
+#else
+  r.handles.resize( members.size() - 1 );
+  for( int64_t i = 1; i < members.size(); ++i )
+    MPI_Send_init( A, 1, dtype, members.shifted( i ),
+                   internal::mpi_int(detail::Tag::Broadcast),
+                   grid.internal_comm(), &r.handles[i-1] );
+  return PersistentRequest( { std::move(r) }, { dtype } );
+#endif
+
+}
+
+/**
+ *  \brief Persistent general 2D broadcast recieve.
+ *
+ *  Same arguments as gebr2d. See gebs2d_init.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]  grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]  scope (local) Scope of the broadcast
+ *  @param[in]  M     (local) Number of rows of the buffer
+ *  @param[in]  N     (local) Number of columns of the buffer
+ *  @param[out] A     (local) Pointer of the buffer to recieve into
+ *  @param[in]  LDA   (local) Leading dimension of the buffer
+ *  @param[in]  RSRC  (local) Process row coordinate of the broadcast root
+ *  @param[in]  CSRC  (local) Process column coordinate of the broadcast root
+ *
+ *  @returns Persistent request for the broadcast
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, PersistentRequest >
+  gebr2d_init( const Grid& grid, const Scope scope,
+               const int64_t M, const int64_t N, T* A, const int64_t LDA,
+               const int64_t RSRC, const int64_t CSRC ) {
+
+  if( not detail::in_scope( grid, scope, RSRC, CSRC ) )
+    throw std::runtime_error("gebr2d_init: broadcast root is not in the scope");
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  PersistentRequest::round r;
+  r.handles.resize(1);
+
+#if MPI_VERSION >= 4
+  detail::scope_members members( grid, scope );
+  auto comm = detail::scope_comm( grid, members );
+  MPI_Bcast_init( A, 1, dtype, detail::scope_index( grid, scope, RSRC, CSRC ),
+                  comm, MPI_INFO_NULL, &r.handles[0] );
+  return PersistentRequest( { std::move(r) }, { dtype }, comm );
+#else
+  MPI_Recv_init( A, 1, dtype, grid.comm_rank( RSRC, CSRC ),
+                 internal::mpi_int(detail::Tag::Broadcast),
+                 grid.internal_comm(), &r.handles[0] );
+  return PersistentRequest( { std::move(r) }, { dtype } );
+#endif
+
+}
+
+/**
+ *  \brief Persistent element-wise 2D sum (all participants recieve the result).
+ *
+ *  Same arguments as gsum2d with RDEST = -1. With MPI-4 this is an
+ *  MPI_Allreduce_init over the scope; otherwise a binomial reduction and
+ *  broadcast built from persistent point-to-point requests. Non-contiguous
+ *  buffers are packed into scratch storage allocated at initialization.
+ *  Initialization is collective over the scope. Several such reductions
+ *  may be in flight on one scope, but must be completed (waited on) in the
+ *  order in which they were started.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     M     (local) Number of rows of the buffer
+ *  @param[in]     N     (local) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *
+ *  @returns Persistent request for the reduction
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, PersistentRequest >
+  gsum2d_init( const Grid& grid, const Scope scope,
+               const int64_t M, const int64_t N, T* A, const int64_t LDA ) {
+
+  detail::scope_members members( grid, scope );
+  const auto n     = M*N;
+  const auto dtype = detail::mpi_type<T>::type();
+  const bool contiguous = LDA == M or N == 1;
+
+  // Working storage (A itself if contiguous)
+  auto scratch = std::make_shared< std::vector<T> >( contiguous ? 0 : n );
+  T* work = contiguous ? A : scratch->data();
+
+  std::function<void()> pack, unpack;
+  if( not contiguous ) {
+    pack = [=]() {
+      for( int64_t j = 0; j < N; ++j ) std::copy_n( A + j*LDA, M, work + j*M );
+    };
+    unpack = [=]() {
+      for( int64_t j = 0; j < N; ++j ) std::copy_n( work + j*M, M, A + j*LDA );
+    };
+  }
+
+  std::vector<PersistentRequest::round> rounds;
+
+#if MPI_VERSION >= 4
+
+  auto comm = detail::scope_comm( grid, members );
+  rounds.emplace_back();
+  rounds.back().handles.resize(1);
+  MPI_Allreduce_init( MPI_IN_PLACE, work, n, dtype, MPI_SUM, comm, 
+                      MPI_INFO_NULL, &rounds.back().handles[0] );
+  rounds.back().before = pack;
+  rounds.back().after  = [=]() { if( unpack ) unpack(); (void)scratch; };
+  return PersistentRequest( std::move(rounds), {}, comm );
+
+#else
+
+  const auto P    = members.size();
+  const auto me   = members.me;
+  const auto tag  = internal::mpi_int(detail::Tag::Reduce);
+  const auto comm = grid.internal_comm();
+  auto recv = std::make_shared< std::vector<T> >( n );
+
+  // Binomial reduction to scope index 0
+  for( int64_t mask = 1; mask < P; mask <<= 1 ) {
+    rounds.emplace_back();
+    rounds.back().handles.resize(1);
+    if( me & mask ) {
+      MPI_Send_init( work, n, dtype, members.ranks[me - mask], tag, comm,
+                     &rounds.back().handles[0] );
+      break;
+    } else if( me + mask < P ) {
+      MPI_Recv_init( recv->data(), n, dtype, members.ranks[me + mask], tag, comm,
+                     &rounds.back().handles[0] );
+      rounds.back().after = [=]() {
+        for( int64_t i = 0; i < n; ++i ) work[i] += (*recv)[i];
+      };
+    } else rounds.pop_back();
+  }
+
+  // Binomial broadcast from scope index 0
+  int64_t top = 1;
+  while( top < P ) top <<= 1;
+  const int64_t low = me & -me;
+
+  if( me != 0 ) {
+    rounds.emplace_back();
+    rounds.back().handles.resize(1);
+    MPI_Recv_init( work, n, dtype, members.ranks[me - low], tag, comm,
+                   &rounds.back().handles[0] );
+  }
+
+  rounds.emplace_back();
+  for( int64_t m = (me == 0 ? top : low) >> 1; m > 0; m >>= 1 )
+  if( me + m < P ) {
+    rounds.back().handles.emplace_back();
+    MPI_Send_init( work, n, dtype, members.ranks[me + m], tag, comm,
+                   &rounds.back().handles.back() );
+  }
+
+  rounds.front().before = pack;
+  rounds.back().after   = [=]() { if( unpack ) unpack(); (void)scratch; (void)recv; };
+  return PersistentRequest( std::move(rounds), {} );
+
+#endif
+
+}
+
+
+/**
+ *  \brief Persistent general point-to-point 2D send of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, PersistentRequest >
+  gesd2d_init( const Grid& grid, const Container& A,
+               const int64_t RDEST, const int64_t CDEST ) {
+
+  return gesd2d_init( grid, A.size(), 1, A.data(), A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief Persistent general point-to-point 2D recieve into a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, PersistentRequest >
+  gerv2d_init( const Grid& grid, Container& A,
+               const int64_t RSRC, const int64_t CSRC ) {
+
+  return gerv2d_init( grid, A.size(), 1, A.data(), A.size(), RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Persistent general 2D broadcast send of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, PersistentRequest >
+  gebs2d_init( const Grid& grid, const Scope scope, const Container& A ) {
+
+  return gebs2d_init( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Persistent general 2D broadcast recieve into a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, PersistentRequest >
+  gebr2d_init( const Grid& grid, const Scope scope, Container& A,
+               const int64_t RSRC, const int64_t CSRC ) {
+
+  return gebr2d_init( grid, scope, A.size(), 1, A.data(), A.size(), RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Persistent element-wise sum of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, PersistentRequest >
+  gsum2d_init( const Grid& grid, const Scope scope, Container& A ) {
+
+  return gsum2d_init( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+}
@@ -0,0 +1,122 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/reduce.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace blacspp {
+
+/**
+ *  \brief Result of a distributed pivot search.
+ *
+ *  @tparam T Type of the searched values.
+ */
+template <typename T>
+struct pivot {
+  T       value; ///< Value of the pivot (not its magnitude)
+  int64_t row;   ///< Global row index of the pivot (-1 if no values were searched)
+  int64_t col;   ///< Global column index of the pivot (-1 if no values were searched)
+};
+
+namespace detail {
+
+  /// |Re| + |Im| magnitude, as used by the BLAS I?AMAX routines
+  template <typename T>
+  inline real_type_t<T> pivot_magnitude( const T& x ) { return std::abs(x); }
+
+  template <typename T>
+  inline T pivot_magnitude( const std::complex<T>& x ) {
+    return std::abs( x.real() ) + std::abs( x.imag() );
+  }
+
+  /**
+   *  \brief Candidate exchanged in each hop of the pivot search tree.
+   *
+   *  The global location is packed into a single 64-bit integer as
+   *  (col << 32) | row, so that the column-major order of locations is
+   *  the integer order of the keys.
+   */
+  template <typename T>
+  struct pivot_candidate {
+
+    real_type_t<T> magnitude;
+    uint64_t       location;
+    T              value;
+
+    static constexpr uint64_t none = std::numeric_limits<uint64_t>::max();
+
+    static uint64_t pack( const int64_t row, const int64_t col ) {
+      return (uint64_t(col) << 32) | uint64_t(row);
+    }
+
+    /// Larger magnitude wins, ties go to the smallest (col,row) location
+    static pivot_candidate select( const pivot_candidate& a, 
+                                   const pivot_candidate& b ) {
+      if( a.location == none ) return b;
+      if( b.location == none ) return a;
+      if( b.magnitude > a.magnitude ) return b;
+      if( a.magnitude > b.magnitude ) return a;
+      return b.location < a.location ? b : a;
+    }
+
+  };
+
+}
+
+/**
+ *  \brief Distributed search for the entry of largest magnitude.
+ *
+ *  Each process contributes n local values together with their global row
+ *  indices; the entry of largest magnitude (|x| for real, |Re|+|Im| for
+ *  complex types, as in I?AMAX) over the scope is returned to every
+ *  participant along with its global (row, col) location. Ties are resolved
+ *  deterministically in favour of the smallest column, then row, index,
+ *  independent of grid shape and reduction order.
+ *
+ *  Each hop of the reduction tree exchanges a single (magnitude, packed
+ *  location, value) candidate, and no process coordinates are involved.
+ *
+ *  Global row and column indices must be smaller than 2^32.
+ *
+ *  @tparam T Type of values. Must be BLACS enabled.
+ *
+ *  @param[in] grid               (local) BLACS grid which defined the communication context.
+ *  @param[in] scope              (local) Scope of the search (Scope::Column for an LU panel)
+ *  @param[in] values             (local) Pointer to the local values
+ *  @param[in] n                  (local) Number of local values (may be 0)
+ *  @param[in] global_row_offsets (local) Global row index of each local value (length n)
+ *  @param[in] global_col         (local) Global column index of the local values
+ *
+ *  @returns The pivot value and its global location
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, pivot<T> >
+  pivot_search( const Grid& grid, const Scope scope, const T* values,
+                const int64_t n, const int64_t* global_row_offsets,
+                const int64_t global_col = 0 ) {
+
+  using candidate = detail::pivot_candidate<T>;
+
+  candidate local{ 0, candidate::none, T(0) };
+  for( int64_t i = 0; i < n; ++i ) {
+    const candidate c{ detail::pivot_magnitude( values[i] ),
+                       candidate::pack( global_row_offsets[i], global_col ),
+                       values[i] };
+    local = candidate::select( local, c );
+  }
+
+  reduce2d( grid, scope, &candidate::select, 1, 1, &local, 1 );
+
+  if( local.location == candidate::none ) return pivot<T>{ T(0), -1, -1 };
+  return pivot<T>{ local.value, int64_t(local.location & 0xffffffffu),
+                   int64_t(local.location >> 32) };
+
+}
+
+}
@@ -0,0 +1,155 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <string>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Measured point-to-point latency and bandwidth between all pairs
+ *  of processes of a communicator.
+ *
+ *  Entries are stored col-major (nprocs x nprocs) and are symmetric. Pairs
+ *  which were not sampled hold the mean of the measured pairs.
+ */
+struct LinkProfile {
+
+  int64_t             nprocs = 0;
+  std::vector<double> latency;       ///< Seconds per message
+  std::vector<double> inv_bandwidth; ///< Seconds per byte
+
+  /**
+   *  \brief Predicted time (s) of a message between two ranks.
+   *
+   *  @param[in] i     First rank
+   *  @param[in] j     Second rank
+   *  @param[in] bytes Message size in bytes
+   */
+  inline double cost( int64_t i, int64_t j, double bytes ) const noexcept {
+    return i == j ? 0. : 
+      latency[i + j*nprocs] + bytes * inv_bandwidth[i + j*nprocs];
+  }
+
+  /**
+   *  \brief Write the profile to a file (local operation).
+   *
+   *  @param[in] fname Name of the file
+   */
+  void save( const std::string& fname ) const;
+
+  /**
+   *  \brief Read a profile written by save (local operation).
+   *
+   *  Throws if the file cannot be read or is not a blacspp link profile.
+   *
+   *  @param[in] fname Name of the file
+   *  @returns         Profile stored in the file
+   */
+  static LinkProfile load( const std::string& fname );
+
+};
+
+/**
+ *  \brief Options for link calibration.
+ */
+struct CalibrationOptions {
+  int64_t repetitions   = 8;       ///< Ping-pongs per message size and pair
+  int64_t message_bytes = 1 << 18; ///< Size of the bandwidth probe
+  int64_t max_rounds    = 0;       ///< Pairing rounds to sample (0 = all P-1)
+};
+
+/**
+ *  \brief Measure the pairwise latency and bandwidth of a communicator.
+ *
+ *  Collective over comm. Pairs are exchanged in rounds of a round-robin
+ *  tournament, so every process takes part in exactly one ping-pong per
+ *  round and all pairs are covered in P-1 rounds. Latency is half the
+ *  fastest round trip of an empty message, inverse bandwidth follows from
+ *  the fastest round trip of a message_bytes message. With max_rounds,
+ *  only that many (evenly spaced) rounds are measured and the remaining
+ *  pairs take the mean of the sampled ones.
+ *
+ *  If cache is non-empty and names a readable profile of the right size,
+ *  it is read by rank 0 and broadcast instead of measuring. Otherwise
+ *  the measured profile is written to cache by rank 0.
+ *
+ *  @param[in] comm  MPI Communicator
+ *  @param[in] opts  Calibration options
+ *  @param[in] cache Optional cache file
+ *  @returns         Profile of comm, identical on every process
+ */
+LinkProfile calibrate_links( MPI_Comm comm, 
+  const CalibrationOptions& opts = CalibrationOptions(),
+  const std::string& cache = "" );
+
+/**
+ *  \brief Relative volume of grid scope traffic used to weigh a placement.
+ */
+struct PlacementWeights {
+  double row_bytes = 1 << 16; ///< Typical message size within process rows
+  double col_bytes = 1 << 16; ///< Typical message size within process columns
+  double row_share = 1.;      ///< Relative number of row scope messages
+  double col_share = 1.;      ///< Relative number of column scope messages
+};
+
+/**
+ *  \brief Cost of a placement under a link profile.
+ *
+ *  Sum over all pairs of processes sharing a process row (column) of the
+ *  predicted message time, weighted by the row (column) share.
+ *
+ *  @param[in] profile Link profile
+ *  @param[in] npr     Number of process rows
+ *  @param[in] npc     Number of process columns
+ *  @param[in] map     Rank of each process coordinate (col-major, npr x npc)
+ *  @param[in] weights Traffic weights
+ *  @returns           Weighted cost of map
+ */
+double placement_cost( const LinkProfile& profile, int64_t npr, int64_t npc,
+  const std::vector<int64_t>& map, 
+  const PlacementWeights& weights = PlacementWeights() );
+
+/**
+ *  \brief Choose a process map which keeps grid scope traffic on fast links.
+ *
+ *  Local operation (deterministic for a given profile). Starts from the
+ *  better of the row- and column-major maps and improves it by pairwise
+ *  swaps of processes until no swap reduces placement_cost (or
+ *  max_sweeps sweeps). The result may be passed to 
+ *  Grid( comm, npr, npc, map.data(), npr ).
+ *
+ *  @param[in] profile    Link profile of the communicator
+ *  @param[in] npr        Number of process rows
+ *  @param[in] npc        Number of process columns
+ *  @param[in] weights    Traffic weights
+ *  @param[in] max_sweeps Maximum number of improvement sweeps
+ *  @returns              Process map (col-major, npr x npc, ldmap = npr)
+ */
+std::vector<int64_t> optimize_placement( const LinkProfile& profile, 
+  int64_t npr, int64_t npc, 
+  const PlacementWeights& weights = PlacementWeights(),
+  int64_t max_sweeps = 8 );
+
+/**
+ *  \brief Construct a BLACS grid placed according to a link profile.
+ *
+ *  Collective over comm.
+ *
+ *  @param[in] comm    MPI Communicator (profile must describe comm)
+ *  @param[in] npr     Number of process rows
+ *  @param[in] npc     Number of process columns
+ *  @param[in] profile Link profile of comm
+ *  @param[in] weights Traffic weights
+ *  @returns           BLACS grid over comm
+ */
+Grid placed_grid( MPI_Comm comm, int64_t npr, int64_t npc, 
+  const LinkProfile& profile, 
+  const PlacementWeights& weights = PlacementWeights() );
+
+}
@@ -0,0 +1,76 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/request.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace blacspp {
+
+/**
+ *  \brief Background thread which drives outstanding requests to completion.
+ *
+ *  Many MPI implementations only progress non-blocking operations inside MPI
+ *  calls. A ProgressEngine owns a thread which repeatedly tests submitted
+ *  requests so that communication overlaps with long local computation.
+ *  Submission is lock-free; the thread sleeps while nothing is in flight.
+ *
+ *  At most one engine may run per process. Requires MPI_THREAD_MULTIPLE.
+ */
+class ProgressEngine {
+
+  struct Node {
+    std::shared_ptr<detail::RequestState> state;
+    Node* next;
+  };
+
+  std::atomic<Node*> head_{nullptr};  ///< Lock-free (MPSC) submission stack
+  std::atomic<bool>  stop_{false};    ///< Shutdown flag
+  std::atomic<bool>  sleeping_{false};///< Whether the thread is (about to be) idle
+
+  std::mutex              mutex_; ///< Guards idle wakeups only
+  std::condition_variable cv_;    ///< Idle wakeup
+
+  std::thread thread_;
+
+  void run( int64_t core );
+
+public:
+
+  /**
+   *  \brief Start the progress thread.
+   *
+   *  @param[in] core CPU core to bind the progress thread to (-1 = unbound)
+   */
+  ProgressEngine( int64_t core = -1 );
+
+  /**
+   *  \brief Stop the progress thread.
+   *
+   *  Outstanding requests are driven to completion before returning.
+   */
+  ~ProgressEngine() noexcept;
+
+  ProgressEngine( const ProgressEngine& ) = delete;
+  ProgressEngine( ProgressEngine&& )      = delete;
+
+  /**
+   *  \brief Hand a request to the progress thread.
+   *
+   *  After submission, Request::test() / Request::wait() observe completion
+   *  as driven by the engine. A request may only be submitted once, and must
+   *  not be tested concurrently with its submission.
+   *
+   *  @param[in] req Request to progress
+   */
+  void submit( Request& req );
+
+};
+
+}
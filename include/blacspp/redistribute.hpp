@@ -0,0 +1,212 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/distribution.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Communication plan moving a block-cyclic matrix between grids.
+ *
+ *  Moves a matrix distributed over a source grid (e.g. before Grid::reshape
+ *  or Grid::shrink) into another block-cyclic distribution over a 
+ *  destination grid. Each element travels once, directly from the process
+ *  which owns it in the source distribution to the process which owns it
+ *  in the destination distribution, and elements which stay on the same
+ *  process are copied locally. Each pair of processes exchanges at most one
+ *  aggregated message, there is no gather to a root.
+ *
+ *  The plan is built from runs of rows and columns over which neither
+ *  distribution changes owner, so its size is proportional to the number of
+ *  blocks along each dimension rather than to the number of elements.
+ */
+class RedistributePlan {
+
+  /// Run of consecutive global indices with constant source and destination owners
+  struct Run {
+    int64_t src_local; ///< First local index in the source distribution
+    int64_t dst_local; ///< First local index in the destination distribution
+    int64_t length;    ///< Number of indices
+  };
+
+  std::shared_ptr<MPI_Comm> comm_; ///< Private duplicate of the plan's communicator
+
+  std::vector< int64_t > src_ranks_; ///< Rank (in comm_) of each source coordinate (col-major)
+  std::vector< int64_t > dst_ranks_; ///< Rank (in comm_) of each destination coordinate (col-major)
+  int64_t src_npr_ = 0, dst_npr_ = 0;
+
+  // Runs owned by this process in the source distribution, per destination
+  // process row (column), and in the destination distribution, per source
+  // process row (column)
+  std::vector< std::vector<Run> > send_rows_, send_cols_;
+  std::vector< std::vector<Run> > recv_rows_, recv_cols_;
+
+public:
+
+  /**
+   *  \brief Construct a redistribution plan.
+   *
+   *  Collective over comm, which must contain every process of both grids.
+   *  Processes which belong to neither grid take part in building the plan
+   *  only. Both distributions must describe a matrix of the same dimensions.
+   *
+   *  @param[in] comm (local)  MPI communicator spanning both grids
+   *  @param[in] src  (local)  Source grid (invalid on processes outside of it)
+   *  @param[in] a    (global) Source distribution
+   *  @param[in] dst  (local)  Destination grid (invalid on processes outside of it)
+   *  @param[in] b    (global) Destination distribution
+   */
+  RedistributePlan( MPI_Comm comm, const Grid& src, const BlockCyclic& a,
+                    const Grid& dst, const BlockCyclic& b );
+
+  /**
+   *  \brief Move local data from the source to the destination distribution.
+   *
+   *  Every process of comm which belongs to either grid must call execute.
+   *
+   *  @tparam T Type of the matrix. Must be BLACS enabled.
+   *
+   *  @param[in]  A   (local) Local source matrix (ignored outside of the source grid)
+   *  @param[in]  LDA (local) Leading dimension of A
+   *  @param[out] B   (local) Local destination matrix (ignored outside of the destination grid)
+   *  @param[in]  LDB (local) Leading dimension of B
+   */
+  template <typename T>
+  detail::enable_if_blacs_supported_t<T>
+    execute( const T* A, const int64_t LDA, T* B, const int64_t LDB ) const;
+
+  /// Number of elements sent to other processes
+  int64_t send_count() const noexcept;
+
+  /// Number of partner processes sent to
+  int64_t partner_count() const noexcept;
+
+};
+
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  RedistributePlan::execute( const T* A, const int64_t LDA, 
+    T* B, const int64_t LDB ) const {
+
+  const auto comm  = *comm_;
+  const auto dtype = detail::mpi_type<T>::type();
+  const auto tag   = internal::mpi_int(detail::Tag::Redistribute);
+
+  int me;
+  MPI_Comm_rank( comm, &me );
+
+  auto volume = []( const std::vector<Run>& rows, const std::vector<Run>& cols ) {
+    int64_t m = 0, n = 0;
+    for( const auto& r : rows ) m += r.length;
+    for( const auto& c : cols ) n += c.length;
+    return m * n;
+  };
+
+  // Column runs outer, row runs inner, in ascending global order on both sides
+  auto pack = [&]( const std::vector<Run>& rows, const std::vector<Run>& cols, 
+                   T* buf ) {
+    for( const auto& c : cols )
+    for( int64_t j = 0; j < c.length; ++j )
+    for( const auto& r : rows ) {
+      const T* col = A + r.src_local + (c.src_local + j) * LDA;
+      buf = std::copy( col, col + r.length, buf );
+    }
+  };
+  auto unpack = [&]( const std::vector<Run>& rows, const std::vector<Run>& cols, 
+                     const T* buf ) {
+    for( const auto& c : cols )
+    for( int64_t j = 0; j < c.length; ++j )
+    for( const auto& r : rows ) {
+      std::copy( buf, buf + r.length, B + r.dst_local + (c.dst_local + j) * LDB );
+      buf += r.length;
+    }
+  };
+
+  std::vector< std::vector<T> > rbuf, sbuf;
+  std::vector< int64_t >        rpr, rpc;
+  std::vector< MPI_Request >    reqs;
+  std::vector< T >              lbuf;
+
+  for( size_t pc = 0; pc < recv_cols_.size(); ++pc )
+  for( size_t pr = 0; pr < recv_rows_.size(); ++pr ) {
+    const auto n = volume( recv_rows_[pr], recv_cols_[pc] );
+    if( not n ) continue;
+    const auto rank = src_ranks_[ pr + pc*src_npr_ ];
+    if( rank == me ) continue;
+    rbuf.emplace_back( n );
+    rpr.emplace_back( pr ); rpc.emplace_back( pc );
+    reqs.emplace_back();
+    MPI_Irecv( rbuf.back().data(), n, dtype, rank, tag, comm, &reqs.back() );
+  }
+
+  for( size_t pc = 0; pc < send_cols_.size(); ++pc )
+  for( size_t pr = 0; pr < send_rows_.size(); ++pr ) {
+    const auto n = volume( send_rows_[pr], send_cols_[pc] );
+    if( not n ) continue;
+    const auto rank = dst_ranks_[ pr + pc*dst_npr_ ];
+    if( rank == me ) {
+      lbuf.resize( n );
+      pack( send_rows_[pr], send_cols_[pc], lbuf.data() );
+      continue;
+    }
+    sbuf.emplace_back( n );
+    pack( send_rows_[pr], send_cols_[pc], sbuf.back().data() );
+    reqs.emplace_back();
+    MPI_Isend( sbuf.back().data(), n, dtype, rank, tag, comm, &reqs.back() );
+  }
+
+  // Data which stays on this process (source coordinate of this process)
+  if( lbuf.size() )
+  for( size_t pc = 0; pc < recv_cols_.size(); ++pc )
+  for( size_t pr = 0; pr < recv_rows_.size(); ++pr )
+  if( src_ranks_[ pr + pc*src_npr_ ] == me ) 
+    unpack( recv_rows_[pr], recv_cols_[pc], lbuf.data() );
+
+  MPI_Waitall( reqs.size(), reqs.data(), MPI_STATUSES_IGNORE );
+
+  for( size_t k = 0; k < rbuf.size(); ++k )
+    unpack( recv_rows_[ rpr[k] ], recv_cols_[ rpc[k] ], rbuf[k].data() );
+
+}
+
+
+/**
+ *  \brief Move a block-cyclic matrix between grids.
+ *
+ *  Convenience wrapper which builds a RedistributePlan and executes it once.
+ *  Collective over comm.
+ *
+ *  @tparam T Type of the matrix. Must be BLACS enabled.
+ *
+ *  @param[in]  comm (local)  MPI communicator spanning both grids
+ *  @param[in]  src  (local)  Source grid
+ *  @param[in]  a    (global) Source distribution
+ *  @param[in]  A    (local)  Local source matrix
+ *  @param[in]  LDA  (local)  Leading dimension of A
+ *  @param[in]  dst  (local)  Destination grid
+ *  @param[in]  b    (global) Destination distribution
+ *  @param[out] B    (local)  Local destination matrix
+ *  @param[in]  LDB  (local)  Leading dimension of B
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  redistribute2d( MPI_Comm comm, 
+                  const Grid& src, const BlockCyclic& a, const T* A, const int64_t LDA,
+                  const Grid& dst, const BlockCyclic& b, T* B, const int64_t LDB ) {
+
+  RedistributePlan( comm, src, a, dst, b ).execute( A, LDA, B, LDB );
+
+}
+
+}
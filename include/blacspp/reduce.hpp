@@ -0,0 +1,376 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace blacspp {
+
+namespace detail {
+
+  /// Largest byte count of a single message (the MPI count is an int)
+  constexpr int64_t max_message_bytes = std::numeric_limits<internal::mpi_int>::max();
+
+  /// Blocking send of a byte buffer of any size, in messages of at most max_message_bytes
+  inline void send_bytes( const void* buf, const int64_t bytes, const int64_t dest,
+    const internal::mpi_int tag, MPI_Comm comm ) {
+    auto ptr = static_cast<const char*>( buf );
+    for( int64_t off = 0; off == 0 or off < bytes; off += max_message_bytes )
+      MPI_Send( ptr + off, std::min( bytes - off, max_message_bytes ), MPI_BYTE,
+                dest, tag, comm );
+  }
+
+  /// Blocking recieve matching send_bytes (messages between a pair are not overtaking)
+  inline void recv_bytes( void* buf, const int64_t bytes, const int64_t src,
+    const internal::mpi_int tag, MPI_Comm comm ) {
+    auto ptr = static_cast<char*>( buf );
+    for( int64_t off = 0; off == 0 or off < bytes; off += max_message_bytes )
+      MPI_Recv( ptr + off, std::min( bytes - off, max_message_bytes ), MPI_BYTE,
+                src, tag, comm, MPI_STATUS_IGNORE );
+  }
+
+  /// Throws unless the reduction destination (RDEST >= 0) shares this process' scope
+  inline void check_destination( const Grid& grid, const Scope scope,
+    const int64_t RDEST, const int64_t CDEST ) {
+    if( RDEST >= 0 and not in_scope( grid, scope, RDEST, CDEST ) )
+      throw std::runtime_error("Reduction destination is not in the scope");
+  }
+
+  /**
+   *  \brief Binomial tree reduction of a contiguous buffer along a scope.
+   *
+   *  Combines in scope order: combine( in, inout, n ) must perform
+   *  inout <- inout (+) in, where inout always holds the contribution of
+   *  the lower scope indices. Only associativity is assumed.
+   *
+   *  @param[in]     members Participants of the scope
+   *  @param[in]     comm    Communicator over which ranks are defined
+   *  @param[in]     combine Whole-buffer combine operation
+   *  @param[in/out] buf     Contribution on entry, result on exit (see dest)
+   *  @param[in]     n       Number of elements of buf
+   *  @param[in]     dest    Scope index of the destination (-1 = all)
+   */
+  template <typename T, class Combine>
+  void tree_reduce( const scope_members& members, MPI_Comm comm,
+    Combine&& combine, T* buf, const int64_t n, const int64_t dest ) {
+
+    const auto P     = members.size();
+    const auto me    = members.me;
+    const auto bytes = int64_t( n * sizeof(T) );
+    const auto tag   = internal::mpi_int(Tag::Reduce);
+
+    std::vector<T> recv( n );
+
+    // Reduce to scope index 0
+    for( int64_t mask = 1; mask < P; mask <<= 1 ) {
+      if( me & mask ) {
+        send_bytes( buf, bytes, members.ranks[me - mask], tag, comm );
+        break;
+      } else if( me + mask < P ) {
+        recv_bytes( recv.data(), bytes, members.ranks[me + mask], tag, comm );
+        combine( static_cast<const T*>(recv.data()), buf, n );
+      }
+    }
+
+    if( dest > 0 ) {
+
+      // Forward the result to the destination
+      if( me == 0 )
+        send_bytes( buf, bytes, members.ranks[dest], tag, comm );
+      else if( me == dest )
+        recv_bytes( buf, bytes, members.ranks[0], tag, comm );
+
+    } else if( dest < 0 ) {
+
+      // Binomial broadcast from scope index 0
+      int64_t mask = 1;
+      while( mask < P ) mask <<= 1;
+
+      const int64_t low = me & -me;
+      if( me != 0 )
+        recv_bytes( buf, bytes, members.ranks[me - low], tag, comm );
+
+      for( int64_t m = (me == 0 ? mask : low) >> 1; m > 0; m >>= 1 )
+        if( me + m < P )
+          send_bytes( buf, bytes, members.ranks[me + m], tag, comm );
+
+    }
+
+  }
+
+  template <typename T, class Op>
+  enable_if_t< is_elementwise_op<Op,T>::value >
+    reduce_packed( const scope_members& members, MPI_Comm comm, Op& op,
+                   T* buf, const int64_t n, const int64_t dest ) {
+
+    // Element-wise operators are applied in a flat loop which the compiler
+    // is free to inline and vectorize
+    tree_reduce( members, comm, [&]( const T* in, T* inout, int64_t cnt ) {
+      for( int64_t i = 0; i < cnt; ++i ) inout[i] = op( inout[i], in[i] );
+    }, buf, n, dest );
+
+  }
+
+  template <typename T, class Op>
+  enable_if_t< not is_elementwise_op<Op,T>::value >
+    reduce_packed( const scope_members& members, MPI_Comm comm, Op& op,
+                   T* buf, const int64_t n, const int64_t dest ) {
+
+    tree_reduce( members, comm, op, buf, n, dest );
+
+  }
+
+}
+
+
+/**
+ *  \brief General 2D reduction with a user-defined operator.
+ *
+ *  Reduces an M x N buffer (col-major) over the specified scope with a C++
+ *  functor, which may either be
+ *    - element-wise:  T op( const T& a, const T& b ), or
+ *    - whole-buffer:  void op( const T* in, T* inout, int64_t n ),
+ *      computing inout <- inout (+) in (e.g. a TSQR R-factor combine).
+ *  The reduction is a binomial tree in scope order (grid coordinate order,
+ *  row-major for Scope::All) where the left operand always holds the lower
+ *  scope indices, so operators need only be associative.
+ *
+ *  T may be any trivially copyable type (masks, (value,index) pairs, ...).
+ *
+ *  @tparam T  Type of buffer. Must be trivially copyable.
+ *  @tparam Op Type of reduction operator.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     op    (local) Reduction operator
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to reduce
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *  @param[in]     RDEST (global) Process row coordinate of destination (-1 = all)
+ *  @param[in]     CDEST (global) Process column coordinate of destination (-1 = all)
+ *
+ */
+template <typename T, class Op>
+detail::enable_if_t< std::is_trivially_copyable<T>::value >
+  reduce2d( const Grid& grid, const Scope scope, Op op,
+            const int64_t M, const int64_t N, T* A, const int64_t LDA,
+            const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+  detail::check_destination( grid, scope, RDEST, CDEST );
+  detail::scope_members members( grid, scope );
+  const auto dest = RDEST < 0 ? -1 :
+    detail::scope_index( grid, scope, RDEST, CDEST );
+
+  if( LDA == M or N == 1 ) {
+    detail::reduce_packed( members, grid.internal_comm(), op, A, M*N, dest );
+  } else {
+    std::vector<T> buf( M*N );
+    for( int64_t j = 0; j < N; ++j ) std::copy_n( A + j*LDA, M, buf.data() + j*M );
+    detail::reduce_packed( members, grid.internal_comm(), op, buf.data(), M*N, dest );
+    for( int64_t j = 0; j < N; ++j ) std::copy_n( buf.data() + j*M, M, A + j*LDA );
+  }
+
+}
+
+/**
+ *  \brief Reduction with a user-defined operator over all elements of a container.
+ *
+ *  Result is recieved by all participants of the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *  @tparam Op        Type of reduction operator.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the reduction
+ *  @param[in]     op    (local) Reduction operator
+ *  @param[in/out] A     (local) Buffer to reduce
+ *
+ */
+template <class Container, class Op>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  reduce2d( const Grid& grid, const Scope scope, Op op, Container& A ) {
+
+  reduce2d( grid, scope, op, A.size(), 1, A.data(), A.size() );
+
+}
+
+
+/**
+ *  \brief Several small reductions fused into a single collective.
+ *
+ *  Buffers of heterogeneous type, length and operation are registered with
+ *  sum(), max() and min(), then packed into one message and reduced together
+ *  by execute(), replacing one latency-bound collective per buffer (e.g. the
+ *  handful of dot products of a Krylov iteration) with one. The packing
+ *  storage is retained, so a FusedReduction may be executed repeatedly.
+ *
+ *  Registered pointers must remain valid for every call to execute().
+ */
+class FusedReduction {
+
+  using combine_fn = void (*)( const char*, char*, int64_t );
+
+  struct segment {
+    void*      ptr;     ///< User buffer
+    int64_t    count;   ///< Number of elements
+    int64_t    bytes;   ///< Size of user buffer in bytes
+    int64_t    offset;  ///< Offset into the packed buffer (aligned)
+    combine_fn combine; ///< Typed element-wise combine
+  };
+
+  struct op_sum { template <typename T> static T apply( const T& a, const T& b ) { return a + b; } };
+  struct op_max { template <typename T> static T apply( const T& a, const T& b ) { return b > a ? b : a; } };
+  struct op_min { template <typename T> static T apply( const T& a, const T& b ) { return b < a ? b : a; } };
+
+  template <typename T, class Op>
+  static void combine( const char* in, char* inout, int64_t n ) {
+    auto x = reinterpret_cast<const T*>( in );
+    auto y = reinterpret_cast<T*>( inout );
+    for( int64_t i = 0; i < n; ++i ) y[i] = Op::apply( y[i], x[i] );
+  }
+
+  template <typename T, class Op>
+  FusedReduction& add( T* A, const int64_t n ) {
+    const int64_t align  = alignof(std::max_align_t);
+    const int64_t offset = (packed_size_ + align - 1) / align * align;
+    const int64_t bytes  = n * sizeof(T);
+    segments_.push_back( segment{ A, n, bytes, offset, &combine<T,Op> } );
+    packed_size_ = offset + bytes;
+    return *this;
+  }
+
+  std::vector<segment> segments_;
+  int64_t              packed_size_ = 0;
+  std::vector<char>    buffer_;
+
+  template <typename T>
+  using enable_if_summable_t = detail::enable_if_t< 
+    std::is_arithmetic<T>::value or detail::blacs_supported<T>::value,
+    FusedReduction& >;
+
+  template <typename T>
+  using enable_if_ordered_t = detail::enable_if_t< 
+    std::is_arithmetic<T>::value, FusedReduction& >;
+
+public:
+
+  /**
+   *  \brief Register a buffer to be summed element-wise.
+   *
+   *  @tparam T Type of buffer. Must be arithmetic or BLACS enabled.
+   *
+   *  @param[in/out] A (local) Pointer of the buffer
+   *  @param[in]     n (global) Number of elements of the buffer
+   */
+  template <typename T>
+  enable_if_summable_t<T> sum( T* A, const int64_t n ) { return add<T,op_sum>( A, n ); }
+
+  /**
+   *  \brief Register a buffer to be reduced by element-wise maximum (by value).
+   *
+   *  @tparam T Type of buffer. Must be arithmetic.
+   *
+   *  @param[in/out] A (local) Pointer of the buffer
+   *  @param[in]     n (global) Number of elements of the buffer
+   */
+  template <typename T>
+  enable_if_ordered_t<T> max( T* A, const int64_t n ) { return add<T,op_max>( A, n ); }
+
+  /**
+   *  \brief Register a buffer to be reduced by element-wise minimum (by value).
+   *
+   *  @tparam T Type of buffer. Must be arithmetic.
+   *
+   *  @param[in/out] A (local) Pointer of the buffer
+   *  @param[in]     n (global) Number of elements of the buffer
+   */
+  template <typename T>
+  enable_if_ordered_t<T> min( T* A, const int64_t n ) { return add<T,op_min>( A, n ); }
+
+  /**
+   *  \brief Register a container to be summed element-wise.
+   *  @param[in/out] A (local) Buffer
+   */
+  template <class Container>
+  auto sum( Container& A ) -> decltype( sum( A.data(), A.size() ) ) {
+    return sum( A.data(), A.size() );
+  }
+
+  /**
+   *  \brief Register a container to be reduced by element-wise maximum.
+   *  @param[in/out] A (local) Buffer
+   */
+  template <class Container>
+  auto max( Container& A ) -> decltype( max( A.data(), A.size() ) ) {
+    return max( A.data(), A.size() );
+  }
+
+  /**
+   *  \brief Register a container to be reduced by element-wise minimum.
+   *  @param[in/out] A (local) Buffer
+   */
+  template <class Container>
+  auto min( Container& A ) -> decltype( min( A.data(), A.size() ) ) {
+    return min( A.data(), A.size() );
+  }
+
+  /// Number of registered buffers
+  inline std::size_t size() const noexcept { return segments_.size(); }
+
+  /// Unregister all buffers
+  void clear() noexcept { segments_.clear(); packed_size_ = 0; }
+
+  /**
+   *  \brief Perform all registered reductions in a single collective.
+   *
+   *  @param[in] grid  (local) BLACS grid which defined the communication context.
+   *  @param[in] scope (local) Scope of the reduction
+   *  @param[in] RDEST (global) Process row coordinate of destination (-1 = all)
+   *  @param[in] CDEST (global) Process column coordinate of destination (-1 = all)
+   */
+  void execute( const Grid& grid, const Scope scope,
+                const int64_t RDEST = -1, const int64_t CDEST = -1 ) {
+
+    if( not segments_.size() ) return;
+
+    detail::check_destination( grid, scope, RDEST, CDEST );
+    detail::scope_members members( grid, scope );
+    const auto dest = RDEST < 0 ? -1 :
+      detail::scope_index( grid, scope, RDEST, CDEST );
+
+    buffer_.resize( packed_size_ );
+    for( const auto& s : segments_ )
+      std::memcpy( buffer_.data() + s.offset, s.ptr, s.bytes );
+
+    const auto& segments = segments_;
+    detail::tree_reduce( members, grid.internal_comm(), 
+      [&]( const char* in, char* inout, int64_t ) {
+        for( const auto& s : segments )
+          s.combine( in + s.offset, inout + s.offset, s.count );
+      }, buffer_.data(), packed_size_, dest );
+
+    if( dest < 0 or dest == members.me )
+    for( const auto& s : segments_ )
+      std::memcpy( s.ptr, buffer_.data() + s.offset, s.bytes );
+
+  }
+
+};
+
+}
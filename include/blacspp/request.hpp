@@ -0,0 +1,93 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace blacspp {
+
+namespace detail {
+
+/**
+ *  \brief Continuation of a multi-round operation.
+ *
+ *  Invoked once all handles of the current round have completed. Posts the
+ *  requests of the next round into handles and returns true, or returns
+ *  false once the operation has finished.
+ */
+using RequestContinuation = std::function< bool( std::vector<MPI_Request>& ) >;
+
+struct RequestState {
+
+  std::vector<MPI_Request> handles; ///< Outstanding MPI requests
+  RequestContinuation      next;    ///< Next round (empty if single round)
+
+  std::atomic<bool> delegated{false}; ///< Whether a ProgressEngine owns handles
+  std::atomic<bool> complete{false};  ///< Completion flag (set by owner)
+
+  RequestState( std::vector<MPI_Request>&& _handles,
+                RequestContinuation&& _next = nullptr );
+
+  bool test_handles();
+  void wait_handles();
+
+};
+
+}
+
+/**
+ *  \brief Handle to an outstanding non-blocking blacspp operation.
+ *
+ *  Copies share the same underlying operation. Once handed to a
+ *  ProgressEngine, completion is driven by the engine and test()/wait()
+ *  only observe it.
+ */
+class Request {
+
+  std::shared_ptr<detail::RequestState> state_ = nullptr;
+
+  friend class ProgressEngine;
+
+public:
+
+  /**
+   *  \brief Construct a trivially complete request.
+   */
+  Request() = default;
+
+  /**
+   *  \brief Construct a request from posted MPI requests.
+   *
+   *  @param[in] handles MPI requests which constitute the operation
+   */
+  Request( std::vector<MPI_Request> handles );
+
+  /**
+   *  \brief Construct a request for a multi-round operation.
+   *
+   *  @param[in] handles MPI requests of the first round
+   *  @param[in] next    Continuation which posts subsequent rounds
+   */
+  Request( std::vector<MPI_Request> handles, detail::RequestContinuation next );
+
+  /**
+   *  \brief Check (without blocking) whether the operation has completed.
+   *  @returns Whether the operation has completed
+   */
+  bool test();
+
+  /**
+   *  \brief Block until the operation has completed.
+   */
+  void wait();
+
+};
+
+}
@@ -0,0 +1,317 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/request.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace blacspp {
+
+namespace detail {
+
+  /**
+   *  \brief State of a recursive doubling (Hillis-Steele) prefix sum.
+   *
+   *  In round k every participant sends its running partial sum to the
+   *  participant 2^k ahead in the scope and adds the one recieved from 2^k
+   *  behind, so the scan completes in ceil(log2 P) rounds.
+   */
+  template <typename T>
+  struct scan_state {
+
+    MPI_Comm             comm;
+    internal::mpi_int    tag;
+    scope_members        members;
+    bool                 exclusive;
+    int64_t              M, N, LDA;
+    T*                   A;
+    int64_t              dist = 1;
+
+    std::vector<T>       partial; ///< Sum over (me-2*dist, me]
+    std::vector<T>       prefix;  ///< Sum over [0, me)
+    std::vector<T>       recv;
+
+    scan_state( const Grid& grid, const Scope scope, const bool _exclusive,
+      const int64_t _M, const int64_t _N, T* _A, const int64_t _LDA ) :
+      comm( grid.internal_comm() ), tag( scope_tag( scope ) ), 
+      members( grid, scope ),
+      exclusive( _exclusive ), M(_M), N(_N), LDA(_LDA), A(_A),
+      partial( _M*_N ), prefix( _M*_N, T(0) ), recv( _M*_N ) {
+
+      for( int64_t j = 0; j < N; ++j )
+        std::copy_n( A + j*LDA, M, partial.data() + j*M );
+
+    }
+
+    /// Each scope has its own tag so that scans over different scopes may overlap
+    static internal::mpi_int scope_tag( const Scope scope ) {
+      const int64_t offset = scope == Scope::Row ? 1 : scope == Scope::Column ? 2 : 0;
+      return internal::mpi_int(Tag::Scan) + offset;
+    }
+
+    /// Post the current round, returns false if there are no more rounds
+    bool post( std::vector<MPI_Request>& handles ) {
+
+      const auto P  = members.size();
+      const auto me = members.me;
+      const auto n  = M*N;
+      const auto dtype = mpi_type<T>::type();
+
+      handles.clear();
+      if( dist >= P ) return false;
+
+      if( me - dist >= 0 ) {
+        handles.emplace_back();
+        MPI_Irecv( recv.data(), n, dtype, members.ranks[me - dist], tag, comm,
+                   &handles.back() );
+      }
+      if( me + dist < P ) {
+        handles.emplace_back();
+        MPI_Isend( partial.data(), n, dtype, members.ranks[me + dist], tag, comm,
+                   &handles.back() );
+      }
+
+      return true;
+
+    }
+
+    /// Fold in the recieved data of the completed round
+    void accumulate() {
+
+      if( members.me - dist >= 0 )
+      for( int64_t i = 0; i < M*N; ++i ) {
+        prefix[i]  += recv[i];
+        partial[i] += recv[i];
+      }
+      dist <<= 1;
+
+    }
+
+    /// Write the result back into A
+    void finalize() {
+
+      const auto& res = exclusive ? prefix : partial;
+      for( int64_t j = 0; j < N; ++j )
+        std::copy_n( res.data() + j*M, M, A + j*LDA );
+
+    }
+
+  };
+
+  template <typename T>
+  Request iscan( const Grid& grid, const Scope scope, const bool exclusive,
+    const int64_t M, const int64_t N, T* A, const int64_t LDA ) {
+
+    auto state = std::make_shared<scan_state<T>>( grid, scope, exclusive,
+                                                  M, N, A, LDA );
+
+    std::vector<MPI_Request> handles;
+    if( not state->post( handles ) ) {
+      state->finalize();
+      return Request();
+    }
+
+    return Request( std::move(handles), [state]( std::vector<MPI_Request>& h ) {
+      state->accumulate();
+      if( state->post( h ) ) return true;
+      state->finalize();
+      return false;
+    });
+
+  }
+
+}
+
+
+/**
+ *  \brief Non-blocking inclusive prefix sum over a grid scope.
+ *
+ *  On completion, A on participant p holds the element-wise sum of A over
+ *  participants [0, p] of the scope, ordered by grid coordinate (row-major
+ *  for Scope::All). Completes in O(log P) rounds of point-to-point messages,
+ *  which are posted as earlier rounds complete in Request::test() / wait()
+ *  (or by a ProgressEngine). A must remain valid until completion and only
+ *  one scan may be outstanding per scope at a time.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to scan
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *
+ *  @returns Request handle for the posted scan
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  iscan2d( const Grid& grid, const Scope scope, const int64_t M,
+           const int64_t N, T* A, const int64_t LDA ) {
+
+  return detail::iscan( grid, scope, false, M, N, A, LDA );
+
+}
+
+/**
+ *  \brief Non-blocking exclusive prefix sum over a grid scope.
+ *
+ *  As iscan2d, but A on participant p holds the sum over [0, p), which is
+ *  zero on the first participant of the scope.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to scan
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *
+ *  @returns Request handle for the posted scan
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  iexscan2d( const Grid& grid, const Scope scope, const int64_t M,
+             const int64_t N, T* A, const int64_t LDA ) {
+
+  return detail::iscan( grid, scope, true, M, N, A, LDA );
+
+}
+
+/**
+ *  \brief Inclusive prefix sum over a grid scope.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to scan
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  scan2d( const Grid& grid, const Scope scope, const int64_t M,
+          const int64_t N, T* A, const int64_t LDA ) {
+
+  iscan2d( grid, scope, M, N, A, LDA ).wait();
+
+}
+
+/**
+ *  \brief Exclusive prefix sum over a grid scope.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in]     M     (global) Number of rows of the buffer
+ *  @param[in]     N     (global) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of the buffer to scan
+ *  @param[in]     LDA   (local) Leading dimension of the buffer
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  exscan2d( const Grid& grid, const Scope scope, const int64_t M,
+            const int64_t N, T* A, const int64_t LDA ) {
+
+  iexscan2d( grid, scope, M, N, A, LDA ).wait();
+
+}
+
+/**
+ *  \brief Inclusive prefix sum over all elements of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in/out] A     (local) Buffer to scan
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  scan2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  scan2d( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Exclusive prefix sum over all elements of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in/out] A     (local) Buffer to scan
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  exscan2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  exscan2d( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Non-blocking inclusive prefix sum over all elements of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in/out] A     (local) Buffer to scan
+ *
+ *  @returns Request handle for the posted scan
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, Request >
+  iscan2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  return iscan2d( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+/**
+ *  \brief Non-blocking exclusive prefix sum over all elements of a container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope of the scan
+ *  @param[in/out] A     (local) Buffer to scan
+ *
+ *  @returns Request handle for the posted scan
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value, Request >
+  iexscan2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  return iexscan2d( grid, scope, A.size(), 1, A.data(), A.size() );
+
+}
+
+}
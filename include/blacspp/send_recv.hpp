@@ -8,6 +8,7 @@
 #include <blacspp/grid.hpp>
 #include <blacspp/wrappers/send_recv.hpp>
 #include <blacspp/util/type_conversions.hpp>
+#include <blacspp/util/transport.hpp>
 
 namespace blacspp {
 
@@ -40,6 +41,45 @@ detail::enable_if_blacs_supported_t<T>
 
 }
 
+/**
+ *  \brief General point-to-point 2D send of a non-BLACS type.
+ *
+ *  Transports any trivially copyable T which is not BLACS enabled (e.g.
+ *  int64_t in LP64 builds, std::size_t or POD structs) as a stream of
+ *  BLACS integers. Must be matched by gerv2d with the same T, M and N.
+ *
+ *  @tparam T Type of buffer to send. Must be trivially copyable.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_transportable_t<T>
+  gesd2d( const Grid& grid, 
+          const int64_t M, const int64_t N, const T* A, const int64_t LDA,
+          const int64_t RDEST, const int64_t CDEST ) {
+
+  using transport = detail::blacs_transport<T>;
+  using word      = typename transport::word;
+
+  if( transport::scaled() ) {
+    const auto k = transport::ratio();
+    wrappers::gesd2d( grid.context(), M*k, N, reinterpret_cast<const word*>(A), 
+                      std::max<int64_t>( LDA*k, 1 ), RDEST, CDEST );
+  } else {
+    auto buf = transport::pack( M, N, A, LDA );
+    wrappers::gesd2d( grid.context(), buf.size(), 1, buf.data(), buf.size(),
+                      RDEST, CDEST );
+  }
+
+}
+
 
 /**
  *  \brief General point-to-point 2D send.
@@ -211,6 +251,44 @@ detail::enable_if_blacs_supported_t<T>
 
 }
 
+/**
+ *  \brief General point-to-point 2D recieve of a non-BLACS type.
+ *
+ *  Matches gesd2d of a trivially copyable, non-BLACS type.
+ *
+ *  @tparam T Type of buffer to recieve. Must be trivially copyable.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_transportable_t<T>
+  gerv2d( const Grid& grid, const int64_t M, const int64_t N,
+          T* A, const int64_t LDA, const int64_t RSRC,
+          const int64_t CSRC ) {
+
+  using transport = detail::blacs_transport<T>;
+  using word      = typename transport::word;
+
+  if( transport::scaled() ) {
+    const auto k = transport::ratio();
+    wrappers::gerv2d( grid.context(), M*k, N, reinterpret_cast<word*>(A), 
+                      std::max<int64_t>( LDA*k, 1 ), RSRC, CSRC );
+  } else {
+    std::vector<word> buf( std::max<int64_t>( transport::packed_words( M, N ), 1 ) );
+    wrappers::gerv2d( grid.context(), buf.size(), 1, buf.data(), buf.size(),
+                      RSRC, CSRC );
+    transport::unpack( M, N, buf, A, LDA );
+  }
+
+}
+
 /**
  *  \brief General point-to-point 2D recieve.
  *
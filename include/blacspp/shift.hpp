@@ -0,0 +1,254 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/request.hpp>
+#include <blacspp/util/type_traits.hpp>
+#include <blacspp/util/mpi_type.hpp>
+#include <blacspp/util/scope.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace blacspp {
+
+
+/**
+ *  \brief Non-blocking circular shift along a grid scope.
+ *
+ *  Simultaneously sends A to the process DISP positions ahead along the scope
+ *  and recieves B from the process DISP positions behind, with wraparound.
+ *  For Scope::Row, (ipr,ipc) sends to (ipr,ipc+DISP) and recieves from
+ *  (ipr,ipc-DISP); Scope::Column shifts along process rows and Scope::All
+ *  along the row-major ordering of the grid. Every process of the scope
+ *  must participate with the same DISP.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope along which to shift
+ *  @param[in]     DISP  (local) Signed shift displacement
+ *  @param[in]     M     (local) Number of rows of the buffers
+ *  @param[in]     N     (local) Number of columns of the buffers
+ *  @param[in]     A     (local) Pointer of buffer to send
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *  @param[in/out] B     (local) Pointer of buffer to store recieved data (may not alias A)
+ *  @param[in]     LDB   (local) Leading dimension of B
+ *
+ *  @returns Request handle for the posted shift
+ */
+template <typename T>
+detail::enable_if_t< detail::blacs_supported<T>::value, Request >
+  ishift( const Grid& grid, const Scope scope, const int64_t DISP,
+          const int64_t M, const int64_t N, const T* A, const int64_t LDA,
+          T* B, const int64_t LDB ) {
+
+  const auto dest = detail::scope_shifted_rank( grid, scope,  DISP );
+  const auto src  = detail::scope_shifted_rank( grid, scope, -DISP );
+
+  auto stype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+  auto rtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDB );
+
+  std::vector<MPI_Request> reqs(2);
+  MPI_Irecv( B, 1, rtype, src,  internal::mpi_int(detail::Tag::Shift),
+             grid.internal_comm(), &reqs[0] );
+  MPI_Isend( A, 1, stype, dest, internal::mpi_int(detail::Tag::Shift),
+             grid.internal_comm(), &reqs[1] );
+
+  MPI_Type_free( &stype );
+  MPI_Type_free( &rtype );
+  return Request( std::move(reqs) );
+
+}
+
+/**
+ *  \brief Circular shift along a grid scope.
+ *
+ *  Blocking counterpart of ishift, performed with a single MPI_Sendrecv so
+ *  that no send/recieve ordering is required of the caller to avoid deadlock.
+ *
+ *  @tparam T Type of buffers. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope along which to shift
+ *  @param[in]     DISP  (local) Signed shift displacement
+ *  @param[in]     M     (local) Number of rows of the buffers
+ *  @param[in]     N     (local) Number of columns of the buffers
+ *  @param[in]     A     (local) Pointer of buffer to send
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *  @param[in/out] B     (local) Pointer of buffer to store recieved data (may not alias A)
+ *  @param[in]     LDB   (local) Leading dimension of B
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  shift( const Grid& grid, const Scope scope, const int64_t DISP,
+         const int64_t M, const int64_t N, const T* A, const int64_t LDA,
+         T* B, const int64_t LDB ) {
+
+  const auto dest = detail::scope_shifted_rank( grid, scope,  DISP );
+  const auto src  = detail::scope_shifted_rank( grid, scope, -DISP );
+
+  auto stype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+  auto rtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDB );
+
+  MPI_Sendrecv( A, 1, stype, dest, internal::mpi_int(detail::Tag::Shift),
+                B, 1, rtype, src,  internal::mpi_int(detail::Tag::Shift),
+                grid.internal_comm(), MPI_STATUS_IGNORE );
+
+  MPI_Type_free( &stype );
+  MPI_Type_free( &rtype );
+
+}
+
+/**
+ *  \brief Circular shift along a grid scope.
+ *
+ *  Buffers managed by C++ containers. Size deduced from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffers.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope along which to shift
+ *  @param[in]     DISP  (local) Signed shift displacement
+ *  @param[in]     A     (local) Buffer to send
+ *  @param[in/out] B     (local) Buffer to store recieved data
+ *
+ */
+template <class Container>
+detail::enable_if_t< detail::has_size_member<Container>::value >
+  shift( const Grid& grid, const Scope scope, const int64_t DISP,
+         const Container& A, Container& B ) {
+
+  shift( grid, scope, DISP, A.size(), 1, A.data(), A.size(), B.data(), B.size() );
+
+}
+
+/**
+ *  \brief In-place circular shift along a grid scope.
+ *
+ *  Replaces the contents of A with those of the process DISP positions
+ *  behind along the scope (MPI_Sendrecv_replace).
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Scope along which to shift
+ *  @param[in]     DISP  (local) Signed shift displacement
+ *  @param[in]     M     (local) Number of rows of the buffer
+ *  @param[in]     N     (local) Number of columns of the buffer
+ *  @param[in/out] A     (local) Pointer of buffer to shift
+ *  @param[in]     LDA   (local) Leading dimension of A
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  shift( const Grid& grid, const Scope scope, const int64_t DISP,
+         const int64_t M, const int64_t N, T* A, const int64_t LDA ) {
+
+  const auto dest = detail::scope_shifted_rank( grid, scope,  DISP );
+  const auto src  = detail::scope_shifted_rank( grid, scope, -DISP );
+
+  auto dtype = detail::matrix_type( detail::mpi_type<T>::type(), M, N, LDA );
+
+  MPI_Sendrecv_replace( A, 1, dtype,
+                        dest, internal::mpi_int(detail::Tag::Shift),
+                        src,  internal::mpi_int(detail::Tag::Shift),
+                        grid.internal_comm(), MPI_STATUS_IGNORE );
+
+  MPI_Type_free( &dtype );
+
+}
+
+
+
+
+
+/**
+ *  \brief Double-buffered storage for repeated in-place circular shifts.
+ *
+ *  Holds a current and a next M x N (col-major, LD = M) buffer. A shift sends
+ *  the current buffer and recieves into the next one, after which the roles
+ *  are swapped without copying. The split start()/finish() form lets the
+ *  caller compute on the current buffer while the shift is in flight, as in
+ *  the systolic steps of Cannon's algorithm.
+ *
+ *  @tparam T Type of buffer. Must be BLACS enabled.
+ */
+template <typename T>
+class ShiftBuffer {
+
+  static_assert( detail::blacs_supported<T>::value, "T must be BLACS enabled" );
+
+  int64_t        M_;          ///< Number of rows
+  int64_t        N_;          ///< Number of columns
+  std::vector<T> buffers_[2]; ///< Current / next storage
+  int            current_;    ///< Index of the current buffer
+  Request        pending_;    ///< Outstanding shift (if any)
+
+public:
+
+  /**
+   *  \brief Allocate a double buffer.
+   *
+   *  @param[in] M Number of rows
+   *  @param[in] N Number of columns
+   */
+  ShiftBuffer( const int64_t M, const int64_t N ) :
+    M_(M), N_(N), current_(0) {
+    buffers_[0].resize( M*N );
+    buffers_[1].resize( M*N );
+  }
+
+  inline int64_t  m()    const noexcept { return M_; }
+  inline int64_t  n()    const noexcept { return N_; }
+  inline int64_t  ld()   const noexcept { return M_; }
+
+  /// Current buffer (valid to read while a shift is in flight)
+  inline T*       data()       noexcept { return buffers_[current_].data(); }
+  inline const T* data() const noexcept { return buffers_[current_].data(); }
+
+  /**
+   *  \brief Post a circular shift of the current buffer.
+   *
+   *  The current buffer may be read, but not modified, until finish().
+   *
+   *  @param[in] grid  (local) BLACS grid which defined the communication context.
+   *  @param[in] scope (local) Scope along which to shift
+   *  @param[in] DISP  (local) Signed shift displacement
+   */
+  void start( const Grid& grid, const Scope scope, const int64_t DISP ) {
+    pending_ = ishift( grid, scope, DISP, M_, N_, buffers_[current_].data(), M_,
+                       buffers_[current_ ^ 1].data(), M_ );
+  }
+
+  /**
+   *  \brief Complete the posted shift and make the recieved data current.
+   */
+  void finish() {
+    pending_.wait();
+    pending_ = Request();
+    current_ ^= 1;
+  }
+
+  /**
+   *  \brief Blocking circular shift of the current buffer.
+   *
+   *  @param[in] grid  (local) BLACS grid which defined the communication context.
+   *  @param[in] scope (local) Scope along which to shift
+   *  @param[in] DISP  (local) Signed shift displacement
+   */
+  void shift( const Grid& grid, const Scope scope, const int64_t DISP ) {
+    blacspp::shift( grid, scope, DISP, M_, N_, buffers_[current_].data(), M_,
+                    buffers_[current_ ^ 1].data(), M_ );
+    current_ ^= 1;
+  }
+
+};
+
+}
@@ -90,6 +90,13 @@ namespace internal {
   };
 
 
+  /**
+   *  \brief Query the level of thread support provided by MPI.
+   *  @returns Thread level as reported by MPI_Query_thread
+   */
+  int64_t mpi_thread_level();
+
+
 
   enum class Uplo : char {
     Upper = 'U',
@@ -107,8 +114,20 @@ namespace internal {
     Column  = 'C'
   };
 
+  /**
+   *  \brief BLACS communication topologies.
+   *
+   *  SRing and MRing are only valid for broadcasts.
+   */
   enum class Topology : char {
-    IRing = 'I'
+    Default        = ' ',
+    IRing          = 'I',
+    DRing          = 'D',
+    SRing          = 'S',
+    MRing          = 'M',
+    Hypercube      = 'H',
+    Tree           = 'T',
+    FullyConnected = 'F'
   };
 
   enum class GridOrder : char {
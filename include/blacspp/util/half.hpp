@@ -0,0 +1,129 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace blacspp {
+
+namespace detail {
+
+  inline uint32_t float_bits( const float f ) {
+    uint32_t u; std::memcpy( &u, &f, sizeof(u) ); return u;
+  }
+
+  inline float bits_float( const uint32_t u ) {
+    float f; std::memcpy( &f, &u, sizeof(f) ); return f;
+  }
+
+  /**
+   *  IEEE binary64 -> binary32 rounded to odd (truncate, set the last bit if
+   *  inexact). Rounding this to nearest even in bfloat16 / binary16 gives
+   *  the correctly rounded result of the double, as binary32 carries more
+   *  than two extra bits; a plain double -> float cast would round twice.
+   */
+  inline float double_to_float_odd( const double d ) {
+    const float f = static_cast<float>( d );
+    if( double(f) == d or d != d ) return f; // Exact or NaN
+    uint32_t u = float_bits( f );
+    if( std::fabs( double(f) ) > std::fabs( d ) ) --u; // Rounded away from zero
+    return bits_float( u | 1u );
+  }
+
+  /// IEEE binary32 -> bfloat16 (round to nearest even, NaN preserving)
+  inline uint16_t float_to_bfloat16( const float f ) {
+    const uint32_t u = float_bits( f );
+    if( (u & 0x7fffffffu) > 0x7f800000u ) return uint16_t( (u >> 16) | 0x40u );
+    return uint16_t( (u + 0x7fffu + ((u >> 16) & 1u)) >> 16 );
+  }
+
+  /// bfloat16 -> IEEE binary32 (exact)
+  inline float bfloat16_to_float( const uint16_t h ) {
+    return bits_float( uint32_t(h) << 16 );
+  }
+
+  /// IEEE binary32 -> binary16 (round to nearest even, with subnormals)
+  inline uint16_t float_to_float16( const float f ) {
+
+    const uint32_t x    = float_bits( f );
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    const uint32_t absx = x & 0x7fffffffu;
+
+    if( absx >= 0x7f800000u ) // Inf / NaN
+      return uint16_t( sign | 0x7c00u | (absx > 0x7f800000u ? 0x200u : 0u) );
+    if( absx >= 0x477ff000u ) // Rounds beyond the largest finite value
+      return uint16_t( sign | 0x7c00u );
+
+    if( absx < 0x38800000u ) { // Subnormal (or zero) result
+      if( absx < 0x33000000u ) return uint16_t( sign );
+      const uint32_t e     = absx >> 23;
+      const uint32_t m     = (absx & 0x7fffffu) | 0x800000u;
+      const uint32_t shift = 126u - e;
+      const uint32_t rem   = m & ((1u << shift) - 1u);
+      const uint32_t mid   = 1u << (shift - 1u);
+      uint32_t hm = m >> shift;
+      if( rem > mid or (rem == mid and (hm & 1u)) ) ++hm;
+      return uint16_t( sign | hm );
+    }
+
+    const uint32_t r = absx - 0x38000000u; // Rebias exponent
+    return uint16_t( sign | ((r + 0xfffu + ((r >> 13) & 1u)) >> 13) );
+
+  }
+
+  /// IEEE binary16 -> binary32 (exact)
+  inline float float16_to_float( const uint16_t h ) {
+
+    const uint32_t sign = uint32_t(h & 0x8000u) << 16;
+    const uint32_t e    = (h >> 10) & 0x1fu;
+    const uint32_t m    = h & 0x3ffu;
+
+    if( e == 0 ) { // Zero / subnormal: m * 2^-24
+      const float v = float(m) * 5.9604644775390625e-8f;
+      return sign ? -v : v;
+    }
+    if( e == 31 ) return bits_float( sign | 0x7f800000u | (m << 13) );
+    return bits_float( sign | ((e + 112u) << 23) | (m << 13) );
+
+  }
+
+}
+
+/**
+ *  \brief bfloat16 storage type (8 exponent / 7 mantissa bits).
+ *
+ *  Storage and conversion only, intended as a wire format for
+ *  mixed-precision transfers. Conversions from float and double are
+ *  correctly rounded (no double rounding through float).
+ */
+struct bfloat16 {
+  uint16_t bits;
+  bfloat16() = default;
+  bfloat16( const float f ) : bits( detail::float_to_bfloat16( f ) ) { }
+  bfloat16( const double d ) : 
+    bits( detail::float_to_bfloat16( detail::double_to_float_odd( d ) ) ) { }
+  operator float() const { return detail::bfloat16_to_float( bits ); }
+};
+
+/**
+ *  \brief IEEE binary16 storage type (5 exponent / 10 mantissa bits).
+ *
+ *  Storage and conversion only, intended as a wire format for
+ *  mixed-precision transfers. Conversions from float and double are
+ *  correctly rounded (no double rounding through float).
+ */
+struct float16 {
+  uint16_t bits;
+  float16() = default;
+  float16( const float f ) : bits( detail::float_to_float16( f ) ) { }
+  float16( const double d ) : 
+    bits( detail::float_to_float16( detail::double_to_float_odd( d ) ) ) { }
+  operator float() const { return detail::float16_to_float( bits ); }
+};
+
+}
@@ -0,0 +1,31 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/config.hpp>
+
+/**
+ *  BLACSPP_INLINE marks the definitions of the BLACS wrappers
+ *  (blacspp/wrappers/impl). With BLACSPP_HEADER_ONLY these are included
+ *  into every translation unit as inline functions, so the wrapper and its
+ *  integer conversions may be inlined into the caller. Otherwise they are
+ *  compiled once into libblacspp.
+ */
+#ifdef BLACSPP_HEADER_ONLY
+  #define BLACSPP_INLINE inline
+#else
+  #define BLACSPP_INLINE
+#endif
+
+/**
+ *  BLACSPP_COLD keeps rarely taken (error) paths out of line and out of the
+ *  caller's hot code.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+  #define BLACSPP_COLD __attribute__((noinline, cold))
+#else
+  #define BLACSPP_COLD
+#endif
@@ -0,0 +1,99 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+
+namespace blacspp {
+namespace detail {
+
+  /**
+   *  \brief Map a BLACS enabled type onto its MPI datatype.
+   *
+   *  @tparam T Type to query, MPI datatype obtained by mpi_type<T>::type()
+   */
+  template <typename T>
+  struct mpi_type;
+
+  template <>
+  struct mpi_type< int32_t > {
+    static MPI_Datatype type() { return MPI_INT32_T; }
+  };
+  template <>
+  struct mpi_type< int64_t > {
+    static MPI_Datatype type() { return MPI_INT64_T; }
+  };
+  template <>
+  struct mpi_type< float > {
+    static MPI_Datatype type() { return MPI_FLOAT; }
+  };
+  template <>
+  struct mpi_type< double > {
+    static MPI_Datatype type() { return MPI_DOUBLE; }
+  };
+  template <>
+  struct mpi_type< internal::scomplex > {
+    static MPI_Datatype type() { return MPI_C_FLOAT_COMPLEX; }
+  };
+  template <>
+  struct mpi_type< internal::dcomplex > {
+    static MPI_Datatype type() { return MPI_C_DOUBLE_COMPLEX; }
+  };
+
+
+  /**
+   *  \brief Create a committed MPI datatype describing a col-major 2D buffer.
+   *
+   *  Caller is responsible for freeing the returned datatype. Freeing is
+   *  allowed as soon as the operations which use it have been posted.
+   *
+   *  @param[in] base MPI datatype of the elements
+   *  @param[in] M    Number of rows
+   *  @param[in] N    Number of columns
+   *  @param[in] LDA  Leading dimension
+   *  @returns        Committed MPI datatype for the M x N buffer
+   */
+  inline MPI_Datatype matrix_type( MPI_Datatype base, const int64_t M,
+    const int64_t N, const int64_t LDA ) {
+
+    MPI_Datatype mat;
+    if( M == LDA or N == 1 )
+      MPI_Type_contiguous( M * N, base, &mat );
+    else
+      MPI_Type_vector( N, M, LDA, base, &mat );
+    MPI_Type_commit( &mat );
+
+    return mat;
+
+  }
+
+  /**
+   *  \brief Message tags reserved for blacspp's MPI-backed operations.
+   *
+   *  Each operation kind uses its own tag on Grid::internal_comm() so
+   *  that concurrently outstanding operations of different kinds cannot
+   *  cross-match.
+   */
+  enum class Tag : internal::mpi_int {
+    PointToPoint  = 100,
+    Broadcast     = 101,
+    Shift         = 102,
+    Allgather     = 103,
+    ReduceScatter = 104,
+    Reduce        = 105,
+    RowSwap       = 107,
+    Alltoall      = 108,
+    Redistribute  = 109,
+    Compressed          = 110, ///< Compressed point-to-point (framed payload)
+    CompressedBroadcast = 111,
+    Mixed               = 112, ///< Mixed-precision point-to-point (converted payload)
+    MixedBroadcast      = 113,
+    Halo          = 200, ///< Block 200-208, one tag per direction
+    Scan          = 210  ///< Block 210-212, one tag per scope
+  };
+
+}
+}
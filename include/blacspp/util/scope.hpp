@@ -0,0 +1,125 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <vector>
+
+namespace blacspp {
+namespace detail {
+
+  /**
+   *  \brief Participants of a scope on a BLACS grid.
+   *
+   *  Ranks are those of Grid::comm() / Grid::internal_comm() and are ordered
+   *  by grid coordinate along the scope (row-major for Scope::All).
+   */
+  struct scope_members {
+
+    std::vector<int64_t> ranks; ///< MPI ranks of the participants
+    int64_t              me;    ///< Index of this process in ranks
+
+    inline int64_t size() const noexcept { return ranks.size(); }
+
+    /// MPI rank of the participant a (cyclic) distance d from this process
+    inline int64_t shifted( int64_t d ) const noexcept {
+      const int64_t p = size();
+      return ranks[ ((me + d) % p + p) % p ];
+    }
+
+    scope_members( const Grid& grid, const Scope scope ) {
+
+      const auto npr = grid.npr();
+      const auto npc = grid.npc();
+
+      if( scope == Scope::Row ) {
+        ranks.resize( npc );
+        for( int64_t pc = 0; pc < npc; ++pc )
+          ranks[pc] = grid.comm_rank( grid.ipr(), pc );
+        me = grid.ipc();
+      } else if( scope == Scope::Column ) {
+        ranks.resize( npr );
+        for( int64_t pr = 0; pr < npr; ++pr )
+          ranks[pr] = grid.comm_rank( pr, grid.ipc() );
+        me = grid.ipr();
+      } else {
+        ranks.resize( npr * npc );
+        for( int64_t pr = 0; pr < npr; ++pr )
+        for( int64_t pc = 0; pc < npc; ++pc )
+          ranks[ pr*npc + pc ] = grid.comm_rank( pr, pc );
+        me = grid.ipr() * npc + grid.ipc();
+      }
+
+    }
+
+  };
+
+  /**
+   *  \brief Index of a process coordinate within a scope.
+   *
+   *  @param[in] grid  BLACS grid
+   *  @param[in] scope Scope of the operation
+   *  @param[in] PROW  Process row coordinate
+   *  @param[in] PCOL  Process column coordinate
+   *  @returns         Index of (PROW,PCOL) in scope_members::ranks
+   */
+  inline int64_t scope_index( const Grid& grid, const Scope scope,
+    const int64_t PROW, const int64_t PCOL ) {
+
+    if( scope == Scope::Row )         return PCOL;
+    else if( scope == Scope::Column ) return PROW;
+    else                              return PROW * grid.npc() + PCOL;
+
+  }
+
+  /**
+   *  \brief Whether a process coordinate shares a scope with this process.
+   *
+   *  @param[in] grid  BLACS grid
+   *  @param[in] scope Scope of the operation
+   *  @param[in] PROW  Process row coordinate
+   *  @param[in] PCOL  Process column coordinate
+   *  @returns         Whether (PROW,PCOL) participates in this process' scope
+   */
+  inline bool in_scope( const Grid& grid, const Scope scope,
+    const int64_t PROW, const int64_t PCOL ) {
+
+    if( scope == Scope::Row )         return PROW == grid.ipr();
+    else if( scope == Scope::Column ) return PCOL == grid.ipc();
+    else                              return true;
+
+  }
+
+  /**
+   *  \brief MPI rank of the process a (cyclic) distance away along a scope.
+   *
+   *  Avoids building the full scope_members table for nearest-neighbour
+   *  style communication.
+   *
+   *  @param[in] grid  BLACS grid
+   *  @param[in] scope Scope of the operation
+   *  @param[in] d     Signed displacement (wraps around)
+   *  @returns         Rank in Grid::comm() of the process d away
+   */
+  inline int64_t scope_shifted_rank( const Grid& grid, const Scope scope,
+    const int64_t d ) {
+
+    const auto npr = grid.npr();
+    const auto npc = grid.npc();
+    auto wrap = []( int64_t i, int64_t n ) { return (i % n + n) % n; };
+
+    if( scope == Scope::Row )
+      return grid.comm_rank( grid.ipr(), wrap( grid.ipc() + d, npc ) );
+    else if( scope == Scope::Column )
+      return grid.comm_rank( wrap( grid.ipr() + d, npr ), grid.ipc() );
+
+    const auto idx = wrap( grid.ipr() * npc + grid.ipc() + d, npr * npc );
+    return grid.comm_rank( idx / npc, idx % npc );
+
+  }
+
+}
+}
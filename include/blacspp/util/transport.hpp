@@ -0,0 +1,80 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/util/type_traits.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace blacspp {
+namespace detail {
+
+  /**
+   *  \brief A SFINAE struct to check if a type may be transported through
+   *  the BLACS point-to-point and broadcast routines as a word stream.
+   *
+   *  Any trivially copyable type which is not itself BLACS enabled
+   *  (e.g. int64_t in LP64 builds, std::size_t or POD structs) is
+   *  transportable.
+   */
+  template <typename T>
+  struct blacs_transportable : public std::integral_constant< bool,
+    std::is_trivially_copyable<T>::value and not blacs_supported<T>::value 
+  > { };
+
+  template <typename T, typename U = void>
+  using enable_if_blacs_transportable_t = 
+    typename std::enable_if< blacs_transportable<T>::value, U >::type;
+
+  /**
+   *  \brief Mapping of a transportable type onto BLACS words.
+   *
+   *  Types whose size and alignment are multiples of the word are sent in
+   *  place by scaling M and LDA by ratio(). All others are packed into a
+   *  contiguous word buffer. The choice depends only on T, so both sides
+   *  of a transfer always agree.
+   */
+  template <typename T>
+  struct blacs_transport {
+
+    using word = internal::blacs_int;
+
+    static constexpr bool scaled() {
+      return sizeof(T) % sizeof(word) == 0 and alignof(T) >= alignof(word);
+    }
+
+    static constexpr int64_t ratio() { return sizeof(T) / sizeof(word); }
+
+    /// Number of words required to hold a packed M x N buffer
+    static int64_t packed_words( const int64_t M, const int64_t N ) {
+      return (M * N * int64_t(sizeof(T)) + sizeof(word) - 1) / sizeof(word);
+    }
+
+    static std::vector<word> pack( const int64_t M, const int64_t N, 
+      const T* A, const int64_t LDA ) {
+
+      std::vector<word> buf( std::max<int64_t>( packed_words( M, N ), 1 ) );
+      auto bytes = reinterpret_cast<char*>( buf.data() );
+      for( int64_t j = 0; j < N; ++j )
+        std::memcpy( bytes + j*M*sizeof(T), A + j*LDA, M*sizeof(T) );
+      return buf;
+
+    }
+
+    static void unpack( const int64_t M, const int64_t N, 
+      const std::vector<word>& buf, T* A, const int64_t LDA ) {
+
+      auto bytes = reinterpret_cast<const char*>( buf.data() );
+      for( int64_t j = 0; j < N; ++j )
+        std::memcpy( A + j*LDA, bytes + j*M*sizeof(T), M*sizeof(T) );
+
+    }
+
+  };
+
+}
+}
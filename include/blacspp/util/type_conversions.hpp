@@ -6,12 +6,53 @@
  */
 #pragma once
 #include <blacspp/types.hpp>
+#include <blacspp/util/inline.hpp>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace blacspp {
 namespace detail  {
 
-  extern internal::blacs_int to_blacs_int( int64_t );
+  /**
+   *  \brief Throw an integer conversion error (cold path of to_blacs_int).
+   *
+   *  @param[in] i Integer which is not representable as blacs_int
+   */
+  [[noreturn]] inline BLACSPP_COLD void blacs_int_conversion_error( int64_t i ) {
+
+    throw std::runtime_error( 
+      "BLACSPP ENCOUNTERED INTEGER CONVERSION ERROR: "
+      "  * INTEGER INPUT = " + std::to_string( i ) + 
+      "  * BLACS INT_MAX = " + 
+      std::to_string( std::numeric_limits<internal::blacs_int>::max() ) );
+
+  }
+
+  /**
+   *  \brief Check if an integer is representable as blacs_int.
+   *
+   *  Always true (and therefore compiled away) for ILP64 BLACS.
+   */
+  constexpr bool fits_blacs_int( int64_t i ) {
+    return std::is_same< internal::blacs_int, int64_t >::value or
+      ( i >= std::numeric_limits<internal::blacs_int>::min() and
+        i <= std::numeric_limits<internal::blacs_int>::max() );
+  }
+
+  /**
+   *  \brief Convert an integer to blacs_int.
+   *
+   *  Throws std::runtime_error if the integer is not representable.
+   *
+   *  @param[in] i Integer to convert
+   *  @returns     i as blacs_int
+   */
+  constexpr internal::blacs_int to_blacs_int( int64_t i ) {
+    return fits_blacs_int( i ) ? internal::blacs_int( i ) :
+      ( blacs_int_conversion_error( i ), internal::blacs_int( 0 ) );
+  }
 
 }
 }
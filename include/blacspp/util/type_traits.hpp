@@ -87,6 +87,33 @@ namespace detail {
 #endif
 
 
+  /**
+   *  \brief Real type underlying a (possibly complex) BLACS type.
+   */
+  template <typename T>
+  struct real_type { using type = T; };
+
+  template <typename T>
+  struct real_type< std::complex<T> > { using type = T; };
+
+  template <typename T>
+  using real_type_t = typename real_type<T>::type;
+
+
+  /**
+   *  \brief A SFINAE struct to check if a functor is an element-wise 
+   *  reduction operator for a type.
+   *
+   *  Element-wise operators are callable as T op( const T&, const T& ).
+   */
+  template <typename Op, typename T, typename = blacspp::detail::void_t<>>
+  struct is_elementwise_op : public std::false_type { };
+
+  template <typename Op, typename T>
+  struct is_elementwise_op< Op, T,
+    blacspp::detail::void_t< decltype( T( std::declval<Op&>()( 
+      std::declval<const T&>(), std::declval<const T&>() ) ) ) >
+  > : public std::true_type { };
 
 }
 }
@@ -27,13 +27,18 @@ detail::enable_if_blacs_supported_t<T>
 template <typename T>
 detail::enable_if_blacs_supported_t<T> 
   gebr2d( const int64_t ICONTXT, const char* SCOPE, const char* TOP,
-          const int64_t M, const int64_t N, T* A, const int64_t LDA );
+          const int64_t M, const int64_t N, T* A, const int64_t LDA,
+          const int64_t RSRC, const int64_t CSRC );
 
 template <typename T>
 detail::enable_if_blacs_supported_t<T> 
   trbr2d( const int64_t ICONTXT, const char* SCOPE, const char* TOP,
           const char* UPLO, const char* DIAG, const int64_t M, const int64_t N, 
-          T* A, const int64_t LDA ); 
+          T* A, const int64_t LDA, const int64_t RSRC, const int64_t CSRC ); 
 
 }
 }
+
+#ifdef BLACSPP_HEADER_ONLY
+#include <blacspp/wrappers/impl/broadcast.hpp>
+#endif
@@ -36,3 +36,7 @@ detail::enable_if_blacs_supported_t<T>
 
 }
 }
+
+#ifdef BLACSPP_HEADER_ONLY
+#include <blacspp/wrappers/impl/combine.hpp>
+#endif
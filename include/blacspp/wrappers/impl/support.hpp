@@ -0,0 +1,229 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/wrappers/support.hpp>
+#include <blacspp/util/inline.hpp>
+#include <blacspp/util/type_conversions.hpp>
+
+#include <vector>
+#include <type_traits>
+
+namespace blacspp {
+namespace wrappers {
+
+using internal::blacs_int;
+
+// Prototypes
+extern "C" {
+
+// Initialization
+void Cblacs_pinfo( blacs_int* IAM, blacs_int* NPROCS );
+void Cblacs_set( const blacs_int ICONTXT, const blacs_int WHAT, const blacs_int* VAL );
+void Cblacs_get( const blacs_int ICONTXT, const blacs_int WHAT, blacs_int* VAL );
+    
+void Cblacs_gridinit( blacs_int* ICONTXT, const char* ORDER, const blacs_int NPROW,
+                      const blacs_int NPCOL );
+    
+void Cblacs_gridmap( blacs_int* ICONTXT, const blacs_int* USERMAP, 
+                     const blacs_int LDUMAP, const blacs_int NPROW, 
+                     const blacs_int NPCOL ); 
+
+// Destruction
+void Cblacs_gridexit( const blacs_int ICONTXT );
+void Cblacs_exit( const blacs_int CONTINUE );
+void Cblacs_abort( const blacs_int ICONTXT, const blacs_int ERRORNUM );
+void Cblacs_freebuff( const blacs_int ICONTXT, const blacs_int WAIT );
+
+// Informational
+void Cblacs_gridinfo( const blacs_int ICONTXT, blacs_int* NPR, blacs_int* NPC,
+                      blacs_int* MYR, blacs_int* MYC );
+blacs_int Cblacs_pnum( const blacs_int ICONTXT, const blacs_int PR, 
+                       const blacs_int PC );
+void Cblacs_pcoord( const blacs_int ICONTXT, const blacs_int PNUM, 
+                    blacs_int* PR, blacs_int* PC );
+
+// Misc
+void Cblacs_barrier( const blacs_int ICONTXT, const char* SCOPE );
+blacs_int Csys2blacs_handle( MPI_Comm c );
+MPI_Comm Cblacs2sys_handle( const blacs_int SYSCTXT );
+void Cfree_blacs_system_handle( const blacs_int handle );
+}
+
+// Initialization
+BLACSPP_INLINE void pinfo( int64_t& IAM, int64_t& NPROCS ) {
+
+  blacs_int _IAM, _NPROCS;
+
+  Cblacs_pinfo( &_IAM, &_NPROCS );
+
+  IAM    = _IAM;
+  NPROCS = _NPROCS;
+
+}
+
+
+BLACSPP_INLINE void set( const int64_t ICONTXT, const int64_t WHAT, const int64_t* VAL ) {
+
+  blacs_int _ICONTXT = detail::to_blacs_int( ICONTXT );
+  blacs_int _WHAT    = detail::to_blacs_int( WHAT );
+  blacs_int _VAL[2];
+
+  _VAL[0] = VAL[0];
+  if( WHAT == 1 )
+    _VAL[1] = VAL[1];
+
+  Cblacs_set( _ICONTXT, _WHAT, _VAL );
+
+  
+}
+
+
+BLACSPP_INLINE void get( const int64_t ICONTXT, const int64_t WHAT, int64_t* VAL ) {
+
+  blacs_int _ICONTXT = detail::to_blacs_int( ICONTXT );
+  blacs_int _WHAT    = detail::to_blacs_int( WHAT );
+  blacs_int _VAL;
+
+  Cblacs_get( _ICONTXT, _WHAT, &_VAL );
+
+  *VAL = _VAL;
+
+}
+
+BLACSPP_INLINE int64_t grid_init( int64_t ICONTXT, const char* ORDER, const int64_t NPROW,
+                   const int64_t NPCOL ) {
+
+  blacs_int _ICONTXT = detail::to_blacs_int( ICONTXT );
+  blacs_int _NPROW   = detail::to_blacs_int( NPROW );
+  blacs_int _NPCOL   = detail::to_blacs_int( NPCOL );
+
+  Cblacs_gridinit( &_ICONTXT, ORDER, _NPROW, _NPCOL );
+
+  return _ICONTXT;
+
+}
+
+
+BLACSPP_INLINE int64_t grid_map( int64_t ICONTXT, const int64_t* USERMAP, 
+                  const int64_t LDUMAP, const int64_t NPROW, 
+                  const int64_t NPCOL ) {
+
+  blacs_int _ICONTXT = detail::to_blacs_int( ICONTXT );
+  blacs_int _NPROW   = detail::to_blacs_int( NPROW );
+  blacs_int _NPCOL   = detail::to_blacs_int( NPCOL );
+
+
+  if( not std::is_same<blacs_int,int64_t>::value ) {
+
+    std::vector<blacs_int> _USERMAP( NPROW * NPCOL );
+    for( int64_t j = 0; j < NPCOL; ++j )
+    for( int64_t i = 0; i < NPROW; ++i )
+      _USERMAP[i + j*NPROW] = USERMAP[i + j*LDUMAP];
+    auto _LDUMAP = _NPROW;
+
+    Cblacs_gridmap( &_ICONTXT, _USERMAP.data(), _LDUMAP, _NPROW, _NPCOL );
+    
+  } else if( std::is_same<blacs_int,int64_t>::value ) {
+
+    Cblacs_gridmap( &_ICONTXT, reinterpret_cast<const blacs_int*>(USERMAP), 
+                    LDUMAP, _NPROW, _NPCOL );
+
+  }
+
+  return _ICONTXT;
+
+}
+
+
+
+
+// Destruction
+BLACSPP_INLINE void grid_exit( const int64_t ICONTXT ) {
+  Cblacs_gridexit( detail::to_blacs_int(ICONTXT) );
+}
+BLACSPP_INLINE void exit( const int64_t CONTINUE ) {
+  Cblacs_exit( detail::to_blacs_int(CONTINUE) );
+}
+BLACSPP_INLINE void abort( const int64_t ICONTXT, const int64_t ERRORNUM ) {
+  Cblacs_abort( detail::to_blacs_int(ICONTXT), 
+                detail::to_blacs_int(ERRORNUM) );
+}
+BLACSPP_INLINE void freebuff( const int64_t ICONTXT, const int64_t WAIT ) {
+  Cblacs_freebuff( detail::to_blacs_int(ICONTXT), 
+                   detail::to_blacs_int(WAIT) );
+}
+
+
+
+
+
+
+// Infortmational
+BLACSPP_INLINE blacs_grid_dim grid_info( const int64_t ICONTXT ) {
+
+  blacs_int npr, npc, ipr, ipc;
+  Cblacs_gridinfo( ICONTXT, &npr, &npc, &ipr, &ipc );
+
+  blacs_grid_dim info;
+  info.np_row = npr;
+  info.np_col = npc;
+  info.my_row = ipr;
+  info.my_col = ipc;
+
+  return info;
+
+}
+
+BLACSPP_INLINE int64_t pnum( const int64_t ICONTXT, const int64_t PROW, 
+                const int64_t PCOL ) {
+
+  auto _ICONTXT = detail::to_blacs_int( ICONTXT );
+  auto _PROW    = detail::to_blacs_int( PROW );
+  auto _PCOL    = detail::to_blacs_int( PCOL );
+
+  return Cblacs_pnum( _ICONTXT, _PROW, _PCOL );
+
+}
+
+BLACSPP_INLINE std::pair< int64_t, int64_t > pcoord( const int64_t ICONTXT, 
+                                      const int64_t PNUM ) {
+
+  auto _ICONTXT = detail::to_blacs_int( ICONTXT );
+  auto _PNUM    = detail::to_blacs_int( PNUM );
+
+  blacs_int ipr, ipc;
+  Cblacs_pcoord( _ICONTXT, _PNUM, &ipr, &ipc );
+
+  std::pair< int64_t, int64_t > coord = {ipr, ipc};
+  return coord;
+
+}
+
+
+// Misc
+BLACSPP_INLINE void barrier( const int64_t ICONTXT, const char* SCOPE ) {
+  Cblacs_barrier( detail::to_blacs_int(ICONTXT), SCOPE );
+}
+
+BLACSPP_INLINE int64_t blacs_from_sys( MPI_Comm c ) {
+
+  return Csys2blacs_handle( c );
+
+}
+
+BLACSPP_INLINE MPI_Comm sys_from_blacs( const int64_t SYSCTXT ) {
+
+  return Cblacs2sys_handle( detail::to_blacs_int(SYSCTXT) );
+
+}
+
+BLACSPP_INLINE void free_sys_handle( const int64_t handle ) {
+  Cfree_blacs_system_handle( detail::to_blacs_int(handle) );
+}
+
+}
+}
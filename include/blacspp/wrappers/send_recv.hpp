@@ -39,3 +39,7 @@ detail::enable_if_blacs_supported_t<T>
 
 }
 }
+
+#ifdef BLACSPP_HEADER_ONLY
+#include <blacspp/wrappers/impl/send_recv.hpp>
+#endif
@@ -41,8 +41,13 @@ std::pair< int64_t, int64_t > pcoord( const int64_t ICONTXT,
 // Misc
 void barrier( const int64_t ICONTXT, const char* SCOPE );
 int64_t blacs_from_sys( MPI_Comm c );
+MPI_Comm sys_from_blacs( const int64_t SYSCTXT );
 void free_sys_handle( const int64_t handle );
 
 
 }
 }
+
+#ifdef BLACSPP_HEADER_ONLY
+#include <blacspp/wrappers/impl/support.hpp>
+#endif
@@ -0,0 +1,199 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/compress.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace blacspp {
+namespace detail {
+
+namespace {
+
+  enum class Encoding : uint8_t {
+    Raw        = 0,
+    Compressed = 1
+  };
+
+  /// Message header, followed by the payload
+  struct header {
+    uint8_t  encoding;
+    uint8_t  elem_size;
+    uint8_t  delta;
+    uint8_t  reserved[5];
+    uint64_t raw_bytes;
+  };
+
+  template <typename U>
+  void delta_encode( uint8_t* data, int64_t n ) {
+    U prev = 0;
+    for( int64_t i = 0; i < n; ++i ) {
+      U x; std::memcpy( &x, data + i*sizeof(U), sizeof(U) );
+      const U d = U(x - prev); prev = x;
+      std::memcpy( data + i*sizeof(U), &d, sizeof(U) );
+    }
+  }
+
+  template <typename U>
+  void delta_decode( uint8_t* data, int64_t n ) {
+    U prev = 0;
+    for( int64_t i = 0; i < n; ++i ) {
+      U d; std::memcpy( &d, data + i*sizeof(U), sizeof(U) );
+      prev = U(prev + d);
+      std::memcpy( data + i*sizeof(U), &prev, sizeof(U) );
+    }
+  }
+
+  bool delta( uint8_t* data, int64_t n, int64_t elem_size, bool encode ) {
+    switch( elem_size ) {
+      case 1: encode ? delta_encode<uint8_t >(data,n) : delta_decode<uint8_t >(data,n); return true;
+      case 2: encode ? delta_encode<uint16_t>(data,n) : delta_decode<uint16_t>(data,n); return true;
+      case 4: encode ? delta_encode<uint32_t>(data,n) : delta_decode<uint32_t>(data,n); return true;
+      case 8: encode ? delta_encode<uint64_t>(data,n) : delta_decode<uint64_t>(data,n); return true;
+      default: return false;
+    }
+  }
+
+  /// PackBits-style run-length encoding, gives up once out exceeds limit
+  bool rle_encode( const uint8_t* in, int64_t n, std::vector<uint8_t>& out,
+    int64_t limit ) {
+
+    int64_t i = 0;
+    while( i < n ) {
+
+      // Length of the run starting at i
+      int64_t run = 1;
+      while( i + run < n and run < 130 and in[i+run] == in[i] ) ++run;
+
+      if( run >= 3 ) {
+        out.push_back( uint8_t(128 + run - 3) );
+        out.push_back( in[i] );
+        i += run;
+      } else {
+        // Literal block up to the next run of 3
+        int64_t j = i;
+        while( j < n and j - i < 128 ) {
+          if( j + 2 < n and in[j] == in[j+1] and in[j] == in[j+2] ) break;
+          ++j;
+        }
+        out.push_back( uint8_t(j - i - 1) );
+        out.insert( out.end(), in + i, in + j );
+        i = j;
+      }
+
+      if( int64_t(out.size()) >= limit ) return false;
+
+    }
+    return true;
+
+  }
+
+  void rle_decode( const uint8_t* in, int64_t n, uint8_t* out, int64_t nout ) {
+
+    int64_t i = 0, o = 0;
+    while( i < n ) {
+      const uint8_t c = in[i++];
+      if( c < 128 ) {
+        const int64_t len = int64_t(c) + 1;
+        if( i + len > n or o + len > nout ) 
+          throw std::runtime_error("Corrupt Compressed Message");
+        std::memcpy( out + o, in + i, len );
+        i += len; o += len;
+      } else {
+        const int64_t len = int64_t(c) - 128 + 3;
+        if( i >= n or o + len > nout ) 
+          throw std::runtime_error("Corrupt Compressed Message");
+        std::memset( out + o, in[i++], len );
+        o += len;
+      }
+    }
+    if( o != nout ) throw std::runtime_error("Corrupt Compressed Message");
+
+  }
+
+}
+
+CompressionStats compress( const void* data, int64_t nelem, int64_t elem_size,
+  bool integral, const CompressionOptions& opts, std::vector<uint8_t>& msg ) {
+
+  const int64_t nbytes = nelem * elem_size;
+  const auto    bytes  = static_cast<const uint8_t*>( data );
+
+  header h{};
+  h.elem_size = uint8_t( elem_size );
+  h.raw_bytes = nbytes;
+
+  msg.clear();
+  msg.resize( sizeof(header) );
+
+  bool compressed = false;
+  if( nbytes >= opts.threshold and elem_size < 256 ) {
+
+    // Delta code integers, then group the k-th byte of every element
+    std::vector<uint8_t> work( bytes, bytes + nbytes ), shuffled( nbytes );
+    h.delta = integral and opts.delta and delta( work.data(), nelem, elem_size, true );
+    for( int64_t b = 0; b < elem_size; ++b )
+    for( int64_t i = 0; i < nelem;     ++i )
+      shuffled[ b*nelem + i ] = work[ i*elem_size + b ];
+
+    compressed = rle_encode( shuffled.data(), nbytes, msg, 
+                             sizeof(header) + nbytes );
+
+  }
+
+  if( compressed ) {
+    h.encoding = uint8_t( Encoding::Compressed );
+  } else {
+    h.encoding = uint8_t( Encoding::Raw );
+    h.delta    = 0;
+    msg.resize( sizeof(header) );
+    msg.insert( msg.end(), bytes, bytes + nbytes );
+  }
+  std::memcpy( msg.data(), &h, sizeof(header) );
+
+  CompressionStats stats;
+  stats.raw_bytes  = nbytes;
+  stats.wire_bytes = msg.size();
+  stats.compressed = compressed;
+  return stats;
+
+}
+
+void decompress( const uint8_t* msg, int64_t nbytes, void* data,
+  int64_t nelem, int64_t elem_size ) {
+
+  if( nbytes < int64_t(sizeof(header)) ) 
+    throw std::runtime_error("Corrupt Compressed Message");
+
+  header h;
+  std::memcpy( &h, msg, sizeof(header) );
+  if( int64_t(h.raw_bytes) != nelem * elem_size or h.elem_size != elem_size )
+    throw std::runtime_error("Compressed Message Size Mismatch");
+
+  auto payload  = msg + sizeof(header);
+  auto npayload = nbytes - int64_t(sizeof(header));
+  auto out      = static_cast<uint8_t*>( data );
+
+  if( h.encoding == uint8_t(Encoding::Raw) ) {
+    if( npayload != int64_t(h.raw_bytes) )
+      throw std::runtime_error("Corrupt Compressed Message");
+    std::memcpy( out, payload, npayload );
+    return;
+  }
+
+  std::vector<uint8_t> shuffled( h.raw_bytes );
+  rle_decode( payload, npayload, shuffled.data(), shuffled.size() );
+  for( int64_t b = 0; b < elem_size; ++b )
+  for( int64_t i = 0; i < nelem;     ++i )
+    out[ i*elem_size + b ] = shuffled[ b*nelem + i ];
+
+  if( h.delta ) delta( out, nelem, elem_size, false );
+
+}
+
+}
+}
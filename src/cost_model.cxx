@@ -0,0 +1,206 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/cost_model.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace blacspp {
+
+namespace {
+
+  const Scope model_scopes[] = { Scope::All, Scope::Row, Scope::Column };
+
+  /// Only broadcasts are distinguished by topology
+  std::tuple< Primitive, Scope, Topology > model_key( Primitive prim, 
+    Scope scope, Topology top ) {
+    return std::make_tuple( prim, scope, 
+      prim == Primitive::Broadcast ? top : Topology::Default );
+  }
+
+  /// Number of processes taking part in a scope
+  int64_t scope_size( const Grid& grid, Scope scope ) {
+    if( scope == Scope::Row    ) return grid.npc();
+    if( scope == Scope::Column ) return grid.npr();
+    return grid.npr() * grid.npc();
+  }
+
+  /// Coordinates of the first and last participants of a scope
+  void scope_ends( const Grid& grid, Scope scope, int64_t* first, 
+    int64_t* last ) {
+    first[0] = scope == Scope::Row    ? grid.ipr() : 0;
+    first[1] = scope == Scope::Column ? grid.ipc() : 0;
+    last[0]  = scope == Scope::Row    ? grid.ipr() : grid.npr() - 1;
+    last[1]  = scope == Scope::Column ? grid.ipc() : grid.npc() - 1;
+  }
+
+  /// Fastest local time of op over a number of synchronized runs
+  template <typename Op>
+  double time_op( const Grid& grid, int64_t repetitions, Op&& op ) {
+
+    double best = std::numeric_limits<double>::max();
+    for( int64_t it = -1; it < repetitions; ++it ) {
+      grid.barrier( Scope::All );
+      const double start = MPI_Wtime();
+      op();
+      if( it >= 0 ) best = std::min( best, MPI_Wtime() - start );
+    }
+    return best;
+
+  }
+
+  /// Least squares fit of t = alpha + beta * x with alpha, beta >= 0
+  AlphaBeta fit_alpha_beta( const std::vector<double>& x, 
+    const double* t ) {
+
+    const double n = x.size();
+    double sx = 0., st = 0., sxx = 0., sxt = 0.;
+    for( size_t k = 0; k < x.size(); ++k ) {
+      sx  += x[k];        st  += t[k];
+      sxx += x[k] * x[k]; sxt += x[k] * t[k];
+    }
+
+    AlphaBeta ab;
+    const double det = n * sxx - sx * sx;
+    if( det > 0. ) {
+      ab.beta  = (n * sxt - sx * st) / det;
+      ab.alpha = (st - ab.beta * sx) / n;
+    } else ab.alpha = st / n;
+
+    if( ab.beta < 0. ) { ab.beta = 0.; ab.alpha = st / n; }
+    if( ab.alpha < 0. ) { 
+      ab.alpha = 0.; 
+      ab.beta  = sxx > 0. ? sxt / sxx : 0.; 
+    }
+
+    return ab;
+
+  }
+
+}
+
+CostModel::CostModel( const Grid& grid, const CostModelOptions& opts ) {
+
+  if( not grid.is_valid() ) 
+    throw std::runtime_error("CostModel requires a valid Grid");
+  if( opts.message_bytes.empty() )
+    throw std::runtime_error("CostModel requires at least one message size");
+
+  // Messages are sent as doubles
+  std::vector<int64_t> count;
+  std::vector<double>  bytes;
+  for( auto b : opts.message_bytes ) {
+    count.push_back( std::max( b / int64_t(sizeof(double)), int64_t(1) ) );
+    bytes.push_back( count.back() * sizeof(double) );
+  }
+  std::vector<double> buffer( *std::max_element( count.begin(), count.end() ) );
+
+  const int64_t nsize = count.size();
+  std::vector< key_type > keys;
+  std::vector< double >   times;
+
+  for( auto scope : model_scopes ) {
+
+    if( scope_size( grid, scope ) < 2 ) {
+      fits_[ model_key( Primitive::PointToPoint, scope, Topology::Default ) ] = AlphaBeta();
+      fits_[ model_key( Primitive::Sum,          scope, Topology::Default ) ] = AlphaBeta();
+      for( auto top : opts.topologies )
+        fits_[ model_key( Primitive::Broadcast,  scope, top ) ] = AlphaBeta();
+      continue;
+    }
+
+    int64_t first[2], last[2];
+    scope_ends( grid, scope, first, last );
+    const bool is_first = grid.ipr() == first[0] and grid.ipc() == first[1];
+    const bool is_last  = grid.ipr() == last[0]  and grid.ipc() == last[1];
+
+    // Ping-pong between the ends of the scope, half the round trip
+    keys.push_back( model_key( Primitive::PointToPoint, scope, Topology::Default ) );
+    for( auto n : count )
+      times.push_back( 0.5 * time_op( grid, opts.repetitions, [&]() {
+        if( is_first ) {
+          gesd2d( grid, n, 1, buffer.data(), n, last[0], last[1] );
+          gerv2d( grid, n, 1, buffer.data(), n, last[0], last[1] );
+        } else if( is_last ) {
+          gerv2d( grid, n, 1, buffer.data(), n, first[0], first[1] );
+          gesd2d( grid, n, 1, buffer.data(), n, first[0], first[1] );
+        }
+      }));
+
+    // Broadcast from the first participant
+    for( auto top : opts.topologies ) {
+      keys.push_back( model_key( Primitive::Broadcast, scope, top ) );
+      for( auto n : count )
+        times.push_back( time_op( grid, opts.repetitions, [&]() {
+          if( is_first ) gebs2d( grid, scope, top, n, 1, buffer.data(), n );
+          else           gebr2d( grid, scope, top, n, 1, buffer.data(), n, 
+                                   first[0], first[1] );
+        }));
+    }
+
+    // Sum with the result on all participants
+    keys.push_back( model_key( Primitive::Sum, scope, Topology::Default ) );
+    for( auto n : count )
+      times.push_back( time_op( grid, opts.repetitions, [&]() {
+        gsum2d( grid, scope, Topology::Default, n, 1, buffer.data(), n );
+      }));
+
+  }
+
+  // Fit to the slowest process so that the model is global
+  MPI_Allreduce( MPI_IN_PLACE, times.data(), times.size(), MPI_DOUBLE,
+                 MPI_MAX, grid.internal_comm() );
+
+  for( size_t i = 0; i < keys.size(); ++i )
+    fits_[ keys[i] ] = fit_alpha_beta( bytes, times.data() + i * nsize );
+
+}
+
+bool CostModel::contains( Primitive prim, Scope scope, Topology top ) const {
+  return fits_.count( model_key( prim, scope, top ) );
+}
+
+AlphaBeta CostModel::fit( Primitive prim, Scope scope, Topology top ) const {
+
+  auto it = fits_.find( model_key( prim, scope, top ) );
+  if( it == fits_.end() )
+    throw std::runtime_error("CostModel has no fit for the requested communication");
+  return it->second;
+
+}
+
+void CostModel::set( Primitive prim, Scope scope, Topology top, 
+  AlphaBeta ab ) {
+  fits_[ model_key( prim, scope, top ) ] = ab;
+}
+
+Topology CostModel::best_broadcast( Scope scope, double bytes ) const {
+
+  bool     found = false;
+  Topology best  = Topology::Default;
+  double   time  = std::numeric_limits<double>::max();
+  for( const auto& f : fits_ ) {
+    if( std::get<0>(f.first) != Primitive::Broadcast or 
+        std::get<1>(f.first) != scope ) continue;
+    if( f.second( bytes ) < time ) {
+      found = true;
+      best  = std::get<2>(f.first);
+      time  = f.second( bytes );
+    }
+  }
+
+  if( not found )
+    throw std::runtime_error("CostModel has no broadcast fit for the requested scope");
+  return best;
+
+}
+
+}
@@ -5,10 +5,16 @@
  *  All rights reserved
  */
 #include <blacspp/grid.hpp>
+#include <blacspp/wrappers/combine.hpp>
 #include <blacspp/wrappers/support.hpp>
 #include <blacspp/util/type_conversions.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 namespace blacspp {
@@ -26,6 +32,20 @@ void Grid::barrier( Scope scope ) const noexcept {
 
 
 
+GridSpec::GridSpec( int64_t _npr, int64_t _npc, GridOrder order ) :
+  npr(_npr), npc(_npc), map(_npr * _npc) {
+
+  for( int64_t pc = 0; pc < npc; ++pc )
+  for( int64_t pr = 0; pr < npr; ++pr )
+    map[ pr + pc*npr ] = order == GridOrder::RowMajor ? pr*npc + pc : pc*npr + pr;
+
+}
+
+GridSpec::GridSpec( int64_t _npr, int64_t _npc, std::vector<int64_t> _map ) :
+  npr(_npr), npc(_npc), map(std::move(_map)) { }
+
+
+
 Grid::Grid() : Grid( MPI_COMM_NULL, 0, 0 ){ }
 
 Grid::Grid( MPI_Comm c, int64_t npr, int64_t npc, GridOrder order ) :
@@ -41,6 +61,13 @@ Grid::Grid( MPI_Comm c, int64_t npr, int64_t npc, GridOrder order ) :
     context_->blacs_handle = 
       wrappers::grid_init( context_->system_handle, &order_char, npr, npc );
 
+    // Rank map (mirrors BLACS_gridinit)
+    context_->rank_map.resize( npr * npc );
+    for( int64_t pc = 0; pc < npc; ++pc )
+    for( int64_t pr = 0; pr < npr; ++pr )
+      context_->rank_map[ pr + pc*npr ] = 
+        order == GridOrder::RowMajor ? pr*npc + pc : pc*npr + pr;
+
     // Grab the grid info
     grid_dim_ = wrappers::grid_info( context_->blacs_handle );
 
@@ -60,6 +87,11 @@ Grid::Grid( MPI_Comm c, int64_t npr, int64_t npc, int64_t* map, int64_t ldmap )
     context_->blacs_handle = 
       wrappers::grid_map( context_->system_handle, map, ldmap, npr, npc );
 
+    context_->rank_map.resize( npr * npc );
+    for( int64_t pc = 0; pc < npc; ++pc )
+    for( int64_t pr = 0; pr < npr; ++pr )
+      context_->rank_map[ pr + pc*npr ] = map[ pr + pc*ldmap ];
+
     // Grab the grid info
     grid_dim_ = wrappers::grid_info( context_->blacs_handle );
 
@@ -93,30 +125,42 @@ Grid::~Grid() noexcept {
 
 namespace detail {
 
-Context::Context(MPI_Comm comm) : mpi(comm) {
-  if( comm != MPI_COMM_NULL )
+Context::Context(MPI_Comm comm, bool _owns_comm) : 
+  mpi(comm), owns_comm(_owns_comm) {
+  if( comm != MPI_COMM_NULL ) {
     system_handle = wrappers::blacs_from_sys( comm );
+    MPI_Comm_dup( comm, &internal_comm );
+  }
 }
 
+Context::Context(MPI_Comm comm, std::shared_ptr<const Context> owner) :
+  mpi(comm), system_handle(owner->system_handle), owns_comm(true),
+  system_owner(owner) { }
+
 Context::~Context() noexcept {
-  if( blacs_handle  >= 0 ) wrappers::grid_exit( blacs_handle );
-  if( mpi.comm() != MPI_COMM_NULL ) wrappers::free_sys_handle( system_handle );
+  if( blacs_handle  >= 0 and owns_grid ) wrappers::grid_exit( blacs_handle );
+  if( system_handle >= 0 and not system_owner ) 
+    wrappers::free_sys_handle( system_handle );
+  if( mpi.comm() != MPI_COMM_NULL ) {
+    if( internal_comm != MPI_COMM_NULL ) MPI_Comm_free( &internal_comm );
+    if( owns_comm ) {
+      MPI_Comm comm = mpi.comm();
+      MPI_Comm_free( &comm );
+    }
+  }
 }
 
-std::shared_ptr<Context> Context::clone() const {
+std::shared_ptr<Context> Context::map_onto( MPI_Comm comm, 
+  bool _owns_comm ) const {
 
-  auto ptr = std::make_shared<Context>(mpi.comm());
+  auto ptr = std::make_shared<Context>(comm, _owns_comm);
+  ptr->rank_map = rank_map;
 
   if( blacs_handle >= 0 ) {
 
     auto grid_dim = wrappers::grid_info( blacs_handle );
-    std::vector<int64_t> pmap( grid_dim.np_row*grid_dim.np_col );
-    for( int64_t pc = 0; pc < grid_dim.np_col; ++pc )
-    for( int64_t pr = 0; pr < grid_dim.np_row; ++pr ) {
-      pmap[ pr + pc*grid_dim.np_row ] = wrappers::pnum( blacs_handle, pr, pc );
-    }
     ptr->blacs_handle = 
-      wrappers::grid_map( ptr->system_handle, pmap.data(), grid_dim.np_row, 
+      wrappers::grid_map( ptr->system_handle, rank_map.data(), grid_dim.np_row, 
                           grid_dim.np_row, grid_dim.np_col );
 
   } else ptr->blacs_handle = -1;
@@ -125,6 +169,76 @@ std::shared_ptr<Context> Context::clone() const {
 
 }
 
+std::shared_ptr<Context> Context::clone() const {
+  return map_onto( mpi.comm(), false );
+}
+
+std::shared_ptr<Context> Context::adopt( int64_t blacs_handle, 
+  blacs_grid_dim& grid_dim ) {
+
+  grid_dim = blacs_grid_dim{};
+  auto ptr = std::make_shared<Context>( MPI_COMM_NULL );
+  if( blacs_handle < 0 ) return ptr;
+
+  grid_dim = wrappers::grid_info( blacs_handle );
+  if( grid_dim.np_row < 0 ) return ptr;
+
+  // System communicator the context was created from (BLACS_GET, WHAT = 10)
+  int64_t system_handle;
+  wrappers::get( blacs_handle, 10, &system_handle );
+  MPI_Comm sys_comm = wrappers::sys_from_blacs( system_handle );
+
+  // Only the grid processes take part from here on: exchange their ranks
+  // in the system communicator through the context itself
+  const int64_t npr = grid_dim.np_row, npc = grid_dim.np_col;
+  const int64_t me  = grid_dim.my_row * npc + grid_dim.my_col;
+  int sys_rank;
+  MPI_Comm_rank( sys_comm, &sys_rank );
+
+  std::vector<internal::blacs_int> sys_ranks( npr * npc, 0 );
+  sys_ranks[me] = sys_rank;
+  const char scope = char(Scope::All), top = char(Topology::Default);
+  wrappers::gsum2d( blacs_handle, &scope, &top, npr * npc, 1, 
+                    sys_ranks.data(), npr * npc, -1, -1 );
+
+  // Communicator of exactly the grid processes, ordered row-major
+  std::vector<int> ranks( sys_ranks.begin(), sys_ranks.end() );
+  MPI_Group sys_group, grid_group;
+  MPI_Comm_group( sys_comm, &sys_group );
+  MPI_Group_incl( sys_group, npr * npc, ranks.data(), &grid_group );
+
+  MPI_Comm comm;
+  MPI_Comm_create_group( sys_comm, grid_group, 0, &comm );
+  MPI_Group_free( &grid_group );
+  MPI_Group_free( &sys_group );
+
+  // No system handle is created, the BLACS context is borrowed
+  ptr->mpi          = mpi_info( comm );
+  ptr->owns_comm    = true;
+  ptr->blacs_handle = blacs_handle;
+  ptr->owns_grid    = false;
+  MPI_Comm_dup( comm, &ptr->internal_comm );
+
+  ptr->rank_map.resize( npr * npc );
+  for( int64_t pc = 0; pc < npc; ++pc )
+  for( int64_t pr = 0; pr < npr; ++pr )
+    ptr->rank_map[ pr + pc*npr ] = pr*npc + pc;
+
+  return ptr;
+
+}
+
+std::shared_ptr<Context> Context::duplicate() const {
+
+  if( mpi.comm() == MPI_COMM_NULL ) 
+    return std::make_shared<Context>( MPI_COMM_NULL );
+
+  MPI_Comm dup;
+  MPI_Comm_dup( mpi.comm(), &dup );
+  return map_onto( dup, true );
+
+}
+
 }
 
 
@@ -140,9 +254,30 @@ Grid::Grid( std::shared_ptr<detail::Context> _context ) : context_(_context) {
 
 }
 
+Grid::Grid( std::shared_ptr<detail::Context> _context, blacs_grid_dim dim ) :
+  context_(_context) { 
+
+  if( is_valid() ) grid_dim_ = dim;
+
+}
+
 Grid Grid::clone() const { 
   return Grid( context_->clone() );
 }
+
+std::vector<Grid> Grid::thread_views( int64_t nthreads ) const {
+
+  if( nthreads > 1 and mpi_thread_level() < MPI_THREAD_MULTIPLE )
+    throw std::runtime_error("Grid::thread_views requires MPI_THREAD_MULTIPLE");
+
+  std::vector<Grid> views;
+  views.reserve( nthreads );
+  for( int64_t i = 0; i < nthreads; ++i )
+    views.emplace_back( context_ ? Grid( context_->duplicate() ) : Grid() );
+
+  return views;
+
+}
 #endif
 
 
@@ -165,4 +300,236 @@ Grid Grid::square_grid( const MPI_Comm& comm, GridOrder order ) {
 
 }
 
+Grid Grid::adopt( int64_t context ) {
+
+  // Context::adopt already queries the grid info, reuse it
+  blacs_grid_dim dim;
+  auto ctx = detail::Context::adopt( context, dim );
+  return Grid( ctx, dim );
+
+}
+
+namespace {
+
+  /// Context of a BLACS grid matching a 2D Cartesian communicator
+  std::shared_ptr<detail::Context> cart_context( MPI_Comm cart, bool owns_comm ) {
+
+    int topo, ndims;
+    MPI_Topo_test( cart, &topo );
+    if( topo == MPI_CART ) MPI_Cartdim_get( cart, &ndims );
+    if( topo != MPI_CART or ndims != 2 )
+      throw std::runtime_error("Grid::from_cart requires a 2D Cartesian communicator");
+
+    int dims[2], periods[2], coords[2];
+    MPI_Cart_get( cart, 2, dims, periods, coords );
+
+    const int64_t npr = dims[0], npc = dims[1];
+    auto ctx = std::make_shared<detail::Context>( cart, owns_comm );
+
+    ctx->rank_map.resize( npr * npc );
+    for( int pc = 0; pc < npc; ++pc )
+    for( int pr = 0; pr < npr; ++pr ) {
+      int c[2] = { pr, pc }, rank;
+      MPI_Cart_rank( cart, c, &rank );
+      ctx->rank_map[ pr + pc*npr ] = rank;
+    }
+
+    ctx->blacs_handle = wrappers::grid_map( ctx->system_handle, 
+      ctx->rank_map.data(), npr, npr, npc );
+
+    return ctx;
+
+  }
+
+  /// Context of a row-major npr x npc grid over ranks (of comm), null elsewhere
+  std::shared_ptr<detail::Context> subset_context( MPI_Comm comm, 
+    const std::vector<int64_t>& ranks, int64_t npr, int64_t npc ) {
+
+    mpi_info info( comm );
+    auto it = std::find( ranks.begin(), ranks.end(), info.rank() );
+    const bool active = it != ranks.end();
+
+    // Idle processes get MPI_COMM_NULL, active ones are ordered as ranks
+    MPI_Comm sub;
+    MPI_Comm_split( comm, active ? 0 : MPI_UNDEFINED, 
+                    active ? int(it - ranks.begin()) : 0, &sub );
+    if( sub == MPI_COMM_NULL ) return nullptr;
+
+    auto ctx = std::make_shared<detail::Context>( sub, true );
+    ctx->rank_map.resize( npr * npc );
+    for( int64_t pc = 0; pc < npc; ++pc )
+    for( int64_t pr = 0; pr < npr; ++pr )
+      ctx->rank_map[ pr + pc*npr ] = pr*npc + pc;
+
+    ctx->blacs_handle = wrappers::grid_map( ctx->system_handle, 
+      ctx->rank_map.data(), npr, npr, npc );
+
+    return ctx;
+
+  }
+
+}
+
+Grid Grid::from_cart( MPI_Comm cart ) {
+
+  if( cart == MPI_COMM_NULL ) return Grid();
+  return Grid( cart_context( cart, false ) );
+
+}
+
+Grid Grid::cartesian( MPI_Comm c, int64_t npr, int64_t npc, bool periodic ) {
+
+  if( c == MPI_COMM_NULL ) return Grid();
+
+  mpi_info info( c );
+  if( npr * npc > info.size() )
+    throw std::runtime_error("NPC * NPR > NPROCS");
+
+  int dims[2]    = { int(npr), int(npc) };
+  int periods[2] = { periodic, periodic };
+
+  // Allow MPI to reorder ranks to match the physical network
+  MPI_Comm cart;
+  MPI_Cart_create( c, 2, dims, periods, 1, &cart );
+
+  if( cart == MPI_COMM_NULL ) return Grid();
+  return Grid( cart_context( cart, true ) );
+
+}
+
+Grid Grid::reshape( int64_t new_npr, int64_t new_npc ) const {
+
+  if( not is_valid() ) return Grid();
+  if( new_npr < 1 or new_npc < 1 or new_npr * new_npc > npr() * npc() )
+    throw std::runtime_error("Grid::reshape: NPR * NPC must be in [1, NPROCS]");
+
+  std::vector<int64_t> ranks;
+  for( int64_t pr = 0; pr < npr(); ++pr )
+  for( int64_t pc = 0; pc < npc(); ++pc )
+    ranks.emplace_back( comm_rank( pr, pc ) );
+  ranks.resize( new_npr * new_npc );
+
+  auto ctx = subset_context( comm(), ranks, new_npr, new_npc );
+  return ctx ? Grid( ctx ) : Grid();
+
+}
+
+Grid Grid::shrink( const std::vector<int64_t>& active_ranks ) const {
+
+  if( not is_valid() ) return Grid();
+
+  const int64_t np = active_ranks.size();
+  std::vector<bool> used( context_->mpi.size(), false );
+  for( auto r : active_ranks ) {
+    if( r < 0 or r >= int64_t(used.size()) or used[r] )
+      throw std::runtime_error("Grid::shrink: active ranks must be distinct ranks of comm()");
+    used[r] = true;
+  }
+  if( np == 0 ) 
+    throw std::runtime_error("Grid::shrink: at least one rank must remain active");
+
+  int64_t npr = std::sqrt( np );
+  while( np % npr ) npr--;
+
+  auto ctx = subset_context( comm(), active_ranks, npr, np / npr );
+  return ctx ? Grid( ctx ) : Grid();
+
+}
+
+std::vector<Grid> Grid::batch( MPI_Comm c, const std::vector<GridSpec>& specs ) {
+
+  if( c == MPI_COMM_NULL or specs.empty() ) 
+    return std::vector<Grid>( specs.size() );
+
+  mpi_info info( c );
+  const int64_t nspec = specs.size();
+
+  // Validate the specs locally and fingerprint them (FNV-1a)
+  std::vector<int64_t> sig( 2 * nspec );
+  for( int64_t i = 0; i < nspec; ++i ) {
+
+    const auto& spec = specs[i];
+    if( spec.npr < 1 or spec.npc < 1 or 
+        int64_t(spec.map.size()) != spec.npr * spec.npc )
+      throw std::runtime_error("Grid::batch: map must hold NPR * NPC ranks");
+
+    std::vector<bool> used( info.size(), false );
+    for( auto r : spec.map ) {
+      if( r < 0 or r >= info.size() or used[r] )
+        throw std::runtime_error("Grid::batch: map must hold distinct ranks of the communicator");
+      used[r] = true;
+    }
+
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&]( int64_t x ) { h = (h ^ uint64_t(x)) * 1099511628211ull; };
+    mix( spec.npr ); mix( spec.npc );
+    for( auto r : spec.map ) mix( r );
+
+    // Max of h and -h gives both extrema in one reduction
+    sig[2*i]   = int64_t( h >> 1 );
+    sig[2*i+1] = -sig[2*i];
+
+  }
+
+  MPI_Allreduce( MPI_IN_PLACE, sig.data(), 2*nspec, MPI_INT64_T, MPI_MAX, c );
+  for( int64_t i = 0; i < nspec; ++i )
+    if( sig[2*i] != -sig[2*i+1] )
+      throw std::runtime_error("Grid::batch: specs differ between processes");
+
+  // All grids share one system handle over c, held by a context without
+  // a communicator of its own
+  auto owner = std::make_shared<detail::Context>( MPI_COMM_NULL );
+  owner->system_handle = wrappers::blacs_from_sys( c );
+
+  // Each grid communicates over a communicator of its members, ordered as
+  // the (col-major) map so that rank_map is the identity. Only members take
+  // part in its creation, and the specs are visited in the same order
+  // everywhere
+  MPI_Group c_group;
+  MPI_Comm_group( c, &c_group );
+
+  std::vector< std::shared_ptr<detail::Context> > contexts( nspec );
+  std::vector< MPI_Request > dups( nspec, MPI_REQUEST_NULL );
+  for( int64_t i = 0; i < nspec; ++i ) {
+
+    const auto& map = specs[i].map;
+    if( std::find( map.begin(), map.end(), info.rank() ) == map.end() ) 
+      continue;
+
+    std::vector<int> ranks( map.begin(), map.end() );
+    MPI_Group group;
+    MPI_Comm  comm;
+    MPI_Group_incl( c_group, ranks.size(), ranks.data(), &group );
+    MPI_Comm_create_group( c, group, i, &comm );
+    MPI_Group_free( &group );
+
+    contexts[i] = std::make_shared<detail::Context>( comm, owner );
+    contexts[i]->rank_map.resize( map.size() );
+    std::iota( contexts[i]->rank_map.begin(), contexts[i]->rank_map.end(), 0 );
+    MPI_Comm_idup( comm, &contexts[i]->internal_comm, &dups[i] );
+
+  }
+  MPI_Group_free( &c_group );
+
+  // BLACS creates communicators of its own, which must not interleave with
+  // the outstanding duplications
+  MPI_Waitall( nspec, dups.data(), MPI_STATUSES_IGNORE );
+
+  // BLACS_GRIDMAP is collective over the system handle, i.e. all of c
+  for( int64_t i = 0; i < nspec; ++i ) {
+    auto handle = wrappers::grid_map( owner->system_handle, 
+      specs[i].map.data(), specs[i].npr, specs[i].npr, specs[i].npc );
+    if( contexts[i] ) contexts[i]->blacs_handle = handle;
+  }
+
+  std::vector<Grid> grids;
+  grids.reserve( nspec );
+  for( int64_t i = 0; i < nspec; ++i )
+    grids.emplace_back( contexts[i] and contexts[i]->blacs_handle >= 0 ? 
+                        Grid( contexts[i] ) : Grid() );
+
+  return grids;
+
+}
+
 }
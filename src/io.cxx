@@ -0,0 +1,127 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/io.hpp>
+
+#include <climits>
+#include <cstring>
+
+namespace blacspp {
+
+namespace {
+
+  constexpr char    matrix_file_magic[8] = { 'B','L','A','C','S','P','P','M' };
+  constexpr int64_t matrix_file_version  = 1;
+
+}
+
+namespace detail {
+
+MPI_File open_matrix_file( MPI_Comm comm, const std::string& fname,
+  bool write, const MatrixFileHeader& header ) {
+
+  const int amode = write ? (MPI_MODE_CREATE | MPI_MODE_WRONLY) 
+                          : MPI_MODE_RDONLY;
+
+  MPI_File fh;
+  if( MPI_File_open( comm, fname.c_str(), amode, MPI_INFO_NULL, &fh ) 
+      != MPI_SUCCESS )
+    throw std::runtime_error("Cannot open " + fname);
+
+  if( write ) {
+
+    MPI_File_set_size( fh, 0 );
+
+    int rank;
+    MPI_Comm_rank( comm, &rank );
+    if( rank == 0 ) {
+      char buf[ matrix_file_header_bytes ] = {};
+      const int64_t fields[7] = { matrix_file_version, int64_t(header.type),
+        header.elem_size, header.M, header.N, header.MB, header.NB };
+      std::memcpy( buf, matrix_file_magic, sizeof(matrix_file_magic) );
+      std::memcpy( buf + sizeof(matrix_file_magic), fields, sizeof(fields) );
+      MPI_File_write_at( fh, 0, buf, matrix_file_header_bytes, MPI_BYTE,
+                         MPI_STATUS_IGNORE );
+    }
+
+  }
+
+  return fh;
+
+}
+
+MatrixFileHeader read_matrix_header( MPI_File fh, MPI_Comm comm, 
+  const std::string& fname ) {
+
+  // Rank 0 reads, everyone validates the same bytes
+  int rank;
+  MPI_Comm_rank( comm, &rank );
+
+  char buf[ matrix_file_header_bytes ] = {};
+  if( rank == 0 )
+    MPI_File_read_at( fh, 0, buf, matrix_file_header_bytes, MPI_BYTE,
+                      MPI_STATUS_IGNORE );
+  MPI_Bcast( buf, matrix_file_header_bytes, MPI_BYTE, 0, comm );
+
+  int64_t fields[7];
+  std::memcpy( fields, buf + sizeof(matrix_file_magic), sizeof(fields) );
+
+  if( std::memcmp( buf, matrix_file_magic, sizeof(matrix_file_magic) ) or
+      fields[0] != matrix_file_version ) {
+    MPI_File_close( &fh );
+    throw std::runtime_error(fname + " is not a blacspp matrix file");
+  }
+
+  MatrixFileHeader header;
+  header.type      = char( fields[1] );
+  header.elem_size = fields[2];
+  header.M         = fields[3];
+  header.N         = fields[4];
+  header.MB        = fields[5];
+  header.NB        = fields[6];
+
+  return header;
+
+}
+
+MPI_Datatype darray_type( const Grid& grid, const BlockCyclic& d, 
+  MPI_Datatype base ) {
+
+  if( d.M > INT_MAX or d.N > INT_MAX or d.MB > INT_MAX or d.NB > INT_MAX )
+    throw std::runtime_error("Matrix dimensions exceed the range of MPI-IO file views");
+
+  // darray places the first block on process 0 and numbers processes 
+  // row-major, so shift the coordinates by the source process
+  const int npr = grid.npr(), npc = grid.npc();
+  const int pr  = (grid.ipr() - d.RSRC + npr) % npr;
+  const int pc  = (grid.ipc() - d.CSRC + npc) % npc;
+
+  int gsizes[2]   = { int(d.M),  int(d.N)  };
+  int distribs[2] = { MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC };
+  int dargs[2]    = { int(d.MB), int(d.NB) };
+  int psizes[2]   = { npr, npc };
+
+  MPI_Datatype type;
+  MPI_Type_create_darray( npr * npc, pr * npc + pc, 2, gsizes, distribs, 
+                          dargs, psizes, MPI_ORDER_FORTRAN, base, &type );
+  MPI_Type_commit( &type );
+
+  return type;
+
+}
+
+}
+
+MatrixFileHeader read_matrix_header( MPI_Comm comm, const std::string& fname ) {
+
+  auto fh     = detail::open_matrix_file( comm, fname, false, MatrixFileHeader() );
+  auto header = detail::read_matrix_header( fh, comm, fname );
+  MPI_File_close( &fh );
+  return header;
+
+}
+
+}
@@ -0,0 +1,78 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/laswp.hpp>
+
+#include <map>
+#include <stdexcept>
+
+namespace blacspp {
+
+RowSwapPlan::RowSwapPlan( const Grid& grid, const int64_t MB,
+  const int64_t RSRC, const int64_t K1, const int64_t K2, 
+  const int64_t* IPIV ) : grid_( grid ) {
+
+  if( MB <= 0 ) throw std::runtime_error("MB must be positive");
+
+  const auto npr = grid.npr();
+  const auto ipr = grid.ipr();
+
+  // Compose the interchanges into a single permutation: final row -> 
+  // original row, for every row touched by the pivots
+  std::map< int64_t, int64_t > source;
+  auto src = [&]( int64_t i ) {
+    auto it = source.find( i );
+    return it == source.end() ? i : it->second;
+  };
+  for( int64_t k = K1; k < K2; ++k ) {
+    const auto piv = IPIV[k - K1];
+    if( piv == k ) continue;
+    const auto sk = src( k ), sp = src( piv );
+    source[k]   = sp;
+    source[piv] = sk;
+  }
+
+  auto owner = [&]( int64_t i ) { return ( i / MB + RSRC ) % npr; };
+  auto local = [&]( int64_t i ) { return ( i / (MB*npr) ) * MB + i % MB; };
+
+  send_rows_.resize( npr );
+  recv_rows_.resize( npr );
+
+  // Both sides traverse the permutation in the same (ascending destination)
+  // order, so the aggregated messages need no row indices
+  for( const auto& m : source ) {
+
+    const auto dst = m.first, from = m.second;
+    if( dst == from ) continue;
+
+    const auto pdst = owner( dst ), psrc = owner( from );
+    if( pdst == ipr and psrc == ipr ) {
+      local_src_.emplace_back( local( from ) );
+      local_dst_.emplace_back( local( dst )  );
+    } else if( psrc == ipr ) {
+      send_rows_[pdst].emplace_back( local( from ) );
+    } else if( pdst == ipr ) {
+      recv_rows_[psrc].emplace_back( local( dst ) );
+    }
+
+  }
+
+}
+
+int64_t RowSwapPlan::send_count() const noexcept {
+  int64_t n = 0;
+  for( const auto& r : send_rows_ ) n += r.size();
+  return n;
+}
+
+int64_t RowSwapPlan::partner_count() const noexcept {
+  int64_t n = 0;
+  for( int64_t p = 0; p < int64_t(send_rows_.size()); ++p )
+    n += send_rows_[p].size() or recv_rows_[p].size();
+  return n;
+}
+
+}
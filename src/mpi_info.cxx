@@ -39,4 +39,13 @@ int64_t mpi_info::rank() const { return rank_; };
 int64_t mpi_info::size() const { return size_; };
 
 
+int64_t mpi_thread_level() {
+
+  internal::mpi_int level;
+  MPI_Query_thread( &level );
+  return level;
+
+}
+
+
 }
@@ -0,0 +1,123 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/persistent.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace blacspp {
+
+PersistentRequest::PersistentRequest() noexcept :
+  comm_( MPI_COMM_NULL ), current_(0), active_(false) { }
+
+PersistentRequest::PersistentRequest( std::vector<round> rounds,
+  std::vector<MPI_Datatype> types, MPI_Comm comm ) :
+  rounds_( std::move(rounds) ), types_( std::move(types) ), comm_( comm ),
+  current_(0), active_(false) { }
+
+PersistentRequest::PersistentRequest( PersistentRequest&& other ) noexcept :
+  rounds_( std::move(other.rounds_) ), types_( std::move(other.types_) ),
+  comm_( other.comm_ ), current_( other.current_ ), active_( other.active_ ) { 
+
+  other.rounds_.clear();
+  other.types_.clear();
+  other.comm_   = MPI_COMM_NULL;
+  other.active_ = false;
+
+}
+
+PersistentRequest& PersistentRequest::operator=( PersistentRequest&& other ) noexcept {
+
+  if( this != &other ) {
+    release();
+    rounds_  = std::move( other.rounds_ );
+    types_   = std::move( other.types_ );
+    comm_    = other.comm_;
+    current_ = other.current_;
+    active_  = other.active_;
+    other.rounds_.clear();
+    other.types_.clear();
+    other.comm_   = MPI_COMM_NULL;
+    other.active_ = false;
+  }
+  return *this;
+
+}
+
+PersistentRequest::~PersistentRequest() noexcept { release(); }
+
+void PersistentRequest::release() noexcept {
+
+  if( active_ ) wait();
+
+  for( auto& r : rounds_ )
+  for( auto& h : r.handles ) 
+    if( h != MPI_REQUEST_NULL ) MPI_Request_free( &h );
+  for( auto& t : types_ ) MPI_Type_free( &t );
+  if( comm_ != MPI_COMM_NULL ) MPI_Comm_free( &comm_ );
+
+  rounds_.clear();
+  types_.clear();
+
+}
+
+void PersistentRequest::start_round() {
+
+  auto& r = rounds_[current_];
+  if( r.before ) r.before();
+  if( r.handles.size() ) MPI_Startall( r.handles.size(), r.handles.data() );
+
+}
+
+void PersistentRequest::start() {
+
+  if( active_ ) throw std::runtime_error("PersistentRequest Already Active");
+  if( not rounds_.size() ) return;
+
+  active_  = true;
+  current_ = 0;
+  start_round();
+
+}
+
+bool PersistentRequest::test() {
+
+  while( active_ ) {
+
+    auto& r = rounds_[current_];
+    internal::mpi_int flag = 1;
+    if( r.handles.size() )
+      MPI_Testall( r.handles.size(), r.handles.data(), &flag, MPI_STATUSES_IGNORE );
+    if( not flag ) return false;
+
+    if( r.after ) r.after();
+    if( ++current_ == rounds_.size() ) active_ = false;
+    else start_round();
+
+  }
+
+  return true;
+
+}
+
+void PersistentRequest::wait() {
+
+  while( active_ ) {
+
+    auto& r = rounds_[current_];
+    if( r.handles.size() )
+      MPI_Waitall( r.handles.size(), r.handles.data(), MPI_STATUSES_IGNORE );
+
+    if( r.after ) r.after();
+    if( ++current_ == rounds_.size() ) active_ = false;
+    else start_round();
+
+  }
+
+}
+
+}
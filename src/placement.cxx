@@ -0,0 +1,308 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/placement.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace blacspp {
+
+namespace {
+
+  constexpr const char* profile_magic = "blacspp-link-profile";
+
+  /// Fastest round trip (s) of a bytes message between me and partner
+  double ping_pong( MPI_Comm comm, int partner, bool initiator, 
+    std::vector<char>& buffer, int bytes, int64_t repetitions ) {
+
+    double best = std::numeric_limits<double>::max();
+
+    // One warm-up exchange to establish the connection
+    for( int64_t it = -1; it < repetitions; ++it ) {
+      const double start = MPI_Wtime();
+      if( initiator ) {
+        MPI_Send( buffer.data(), bytes, MPI_BYTE, partner, 0, comm );
+        MPI_Recv( buffer.data(), bytes, MPI_BYTE, partner, 0, comm, 
+                  MPI_STATUS_IGNORE );
+      } else {
+        MPI_Recv( buffer.data(), bytes, MPI_BYTE, partner, 0, comm, 
+                  MPI_STATUS_IGNORE );
+        MPI_Send( buffer.data(), bytes, MPI_BYTE, partner, 0, comm );
+      }
+      if( it >= 0 ) best = std::min( best, MPI_Wtime() - start );
+    }
+
+    return best;
+
+  }
+
+  /// Partner of rank in round of a round-robin tournament over nslots
+  int64_t tournament_partner( int64_t rank, int64_t round, int64_t nslots ) {
+
+    const int64_t m = nslots - 1;
+    if( rank == m ) {
+      // The fixed slot meets the rank i with 2i = round (mod m)
+      for( int64_t i = 0; i < m; ++i )
+        if( (2*i) % m == round ) return i;
+    }
+
+    const int64_t p = ((round - rank) % m + m) % m;
+    return p == rank ? m : p;
+
+  }
+
+  LinkProfile measure_links( MPI_Comm comm, const CalibrationOptions& opts ) {
+
+    mpi_info info( comm );
+    const int64_t np = info.size(), me = info.rank();
+
+    LinkProfile profile;
+    profile.nprocs = np;
+    profile.latency.assign( np*np, 0. );
+    profile.inv_bandwidth.assign( np*np, 0. );
+    if( np == 1 ) return profile;
+
+    // Odd process counts sit out one pairing per round
+    const int64_t nslots  = np + (np % 2);
+    const int64_t nrounds = nslots - 1;
+    const int64_t nsample = (opts.max_rounds > 0) ? 
+      std::min( opts.max_rounds, nrounds ) : nrounds;
+
+    const int large = int( std::max( opts.message_bytes, int64_t(1) ) );
+    std::vector<char>   buffer( large );
+    std::vector<double> measured( np*np, 0. );
+
+    for( int64_t s = 0; s < nsample; ++s ) {
+
+      const int64_t round   = (s * nrounds) / nsample;
+      const int64_t partner = tournament_partner( me, round, nslots );
+      if( partner >= np ) continue;
+
+      const bool initiator = me < partner;
+      const double t_small = 
+        ping_pong( comm, partner, initiator, buffer, 0, opts.repetitions );
+      const double t_large = 
+        ping_pong( comm, partner, initiator, buffer, large, opts.repetitions );
+
+      // Both ends measure, the initiator reports
+      if( initiator ) {
+        const double lat = t_small / 2.;
+        const double ibw = std::max( t_large / 2. - lat, 0. ) / large;
+        for( auto idx : { me + partner*np, partner + me*np } ) {
+          profile.latency[idx]       = lat;
+          profile.inv_bandwidth[idx] = ibw;
+          measured[idx]              = 1.;
+        }
+      }
+
+    }
+
+    MPI_Allreduce( MPI_IN_PLACE, profile.latency.data(), np*np, MPI_DOUBLE, 
+                   MPI_SUM, comm );
+    MPI_Allreduce( MPI_IN_PLACE, profile.inv_bandwidth.data(), np*np, 
+                   MPI_DOUBLE, MPI_SUM, comm );
+    MPI_Allreduce( MPI_IN_PLACE, measured.data(), np*np, MPI_DOUBLE, 
+                   MPI_SUM, comm );
+
+    // Pairs which were not sampled take the mean of those which were
+    double lat_mean = 0., ibw_mean = 0., count = 0.;
+    for( int64_t i = 0; i < np*np; ++i ) 
+    if( measured[i] > 0. ) {
+      lat_mean += profile.latency[i];
+      ibw_mean += profile.inv_bandwidth[i];
+      count    += 1.;
+    }
+    if( count > 0. ) { lat_mean /= count; ibw_mean /= count; }
+
+    for( int64_t j = 0; j < np; ++j )
+    for( int64_t i = 0; i < np; ++i ) 
+    if( i != j and measured[i + j*np] == 0. ) {
+      profile.latency[i + j*np]       = lat_mean;
+      profile.inv_bandwidth[i + j*np] = ibw_mean;
+    }
+
+    return profile;
+
+  }
+
+  /// Weighted cost of the links of position pos (holding rank) to its row and column peers
+  double position_cost( const LinkProfile& profile, int64_t npr, int64_t npc,
+    const std::vector<int64_t>& map, int64_t pos, 
+    const PlacementWeights& weights ) {
+
+    const int64_t pr = pos % npr, pc = pos / npr, rank = map[pos];
+
+    double cost = 0.;
+    for( int64_t j = 0; j < npc; ++j ) if( j != pc )
+      cost += weights.row_share * 
+        profile.cost( rank, map[pr + j*npr], weights.row_bytes );
+    for( int64_t i = 0; i < npr; ++i ) if( i != pr )
+      cost += weights.col_share * 
+        profile.cost( rank, map[i + pc*npr], weights.col_bytes );
+
+    return cost;
+
+  }
+
+}
+
+void LinkProfile::save( const std::string& fname ) const {
+
+  std::ofstream file( fname );
+  if( not file ) throw std::runtime_error("Cannot open " + fname);
+
+  file << profile_magic << " 1 " << nprocs << "\n";
+  file << std::setprecision( std::numeric_limits<double>::max_digits10 );
+  for( auto x : latency )       file << x << "\n";
+  for( auto x : inv_bandwidth ) file << x << "\n";
+
+  if( not file ) throw std::runtime_error("Error writing " + fname);
+
+}
+
+LinkProfile LinkProfile::load( const std::string& fname ) {
+
+  std::ifstream file( fname );
+  if( not file ) throw std::runtime_error("Cannot open " + fname);
+
+  std::string magic;
+  int64_t     version = 0;
+  LinkProfile profile;
+  file >> magic >> version >> profile.nprocs;
+  if( not file or magic != profile_magic or version != 1 or 
+      profile.nprocs < 0 )
+    throw std::runtime_error(fname + " is not a blacspp link profile");
+
+  const int64_t n = profile.nprocs * profile.nprocs;
+  profile.latency.resize( n );
+  profile.inv_bandwidth.resize( n );
+  for( auto& x : profile.latency )       file >> x;
+  for( auto& x : profile.inv_bandwidth ) file >> x;
+
+  if( not file ) throw std::runtime_error("Truncated link profile " + fname);
+
+  return profile;
+
+}
+
+LinkProfile calibrate_links( MPI_Comm comm, const CalibrationOptions& opts,
+  const std::string& cache ) {
+
+  // Keep calibration traffic off the user's communicator
+  MPI_Comm cal;
+  MPI_Comm_dup( comm, &cal );
+  mpi_info info( cal );
+
+  // Rank 0 reads the cache and shares it if it describes this communicator
+  LinkProfile profile;
+  int64_t cached = 0;
+  if( cache.size() and info.rank() == 0 ) {
+    try {
+      profile = LinkProfile::load( cache );
+      cached  = profile.nprocs == info.size();
+    } catch( const std::runtime_error& ) { cached = 0; }
+  }
+  MPI_Bcast( &cached, 1, MPI_INT64_T, 0, cal );
+
+  if( cached ) {
+
+    const int64_t n = info.size() * info.size();
+    profile.nprocs = info.size();
+    profile.latency.resize( n );
+    profile.inv_bandwidth.resize( n );
+    MPI_Bcast( profile.latency.data(), n, MPI_DOUBLE, 0, cal );
+    MPI_Bcast( profile.inv_bandwidth.data(), n, MPI_DOUBLE, 0, cal );
+
+  } else {
+
+    profile = measure_links( cal, opts );
+    if( cache.size() and info.rank() == 0 ) profile.save( cache );
+
+  }
+
+  MPI_Comm_free( &cal );
+  return profile;
+
+}
+
+double placement_cost( const LinkProfile& profile, int64_t npr, int64_t npc,
+  const std::vector<int64_t>& map, const PlacementWeights& weights ) {
+
+  // Each link is seen from both of its ends
+  double cost = 0.;
+  for( int64_t pos = 0; pos < npr*npc; ++pos )
+    cost += position_cost( profile, npr, npc, map, pos, weights );
+  return cost / 2.;
+
+}
+
+std::vector<int64_t> optimize_placement( const LinkProfile& profile,
+  int64_t npr, int64_t npc, const PlacementWeights& weights, 
+  int64_t max_sweeps ) {
+
+  const int64_t np = npr * npc;
+  if( np != profile.nprocs )
+    throw std::runtime_error("NPC * NPR != NPROCS");
+
+  // Start from the cheaper of the row- and column-major maps
+  std::vector<int64_t> row_major( np ), col_major( np );
+  for( int64_t pc = 0; pc < npc; ++pc )
+  for( int64_t pr = 0; pr < npr; ++pr ) {
+    row_major[ pr + pc*npr ] = pr*npc + pc;
+    col_major[ pr + pc*npr ] = pc*npr + pr;
+  }
+
+  auto map = 
+    placement_cost( profile, npr, npc, col_major, weights ) < 
+    placement_cost( profile, npr, npc, row_major, weights ) ?
+      col_major : row_major;
+
+  // Pairwise swap descent. Only the rows and columns of the two positions
+  // change, and their mutual link (if any) costs the same either way.
+  auto pair_cost = [&]( int64_t a, int64_t b ) {
+    return position_cost( profile, npr, npc, map, a, weights ) +
+           position_cost( profile, npr, npc, map, b, weights );
+  };
+
+  for( int64_t sweep = 0; sweep < max_sweeps; ++sweep ) {
+
+    bool improved = false;
+    for( int64_t a = 0;   a < np; ++a )
+    for( int64_t b = a+1; b < np; ++b ) {
+
+      const double before = pair_cost( a, b );
+      std::swap( map[a], map[b] );
+      const double after  = pair_cost( a, b );
+
+      // Require a relative gain to stay clear of round-off cycling
+      if( after < before * (1. - 1e-12) ) improved = true;
+      else std::swap( map[a], map[b] );
+
+    }
+
+    if( not improved ) break;
+
+  }
+
+  return map;
+
+}
+
+Grid placed_grid( MPI_Comm comm, int64_t npr, int64_t npc, 
+  const LinkProfile& profile, const PlacementWeights& weights ) {
+
+  if( comm == MPI_COMM_NULL ) return Grid();
+
+  auto map = optimize_placement( profile, npr, npc, weights );
+  return Grid( comm, npr, npc, map.data(), npr );
+
+}
+
+}
@@ -0,0 +1,114 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/progress.hpp>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace blacspp {
+
+namespace {
+  std::atomic<bool> engine_active{false};
+}
+
+ProgressEngine::ProgressEngine( int64_t core ) {
+
+  if( mpi_thread_level() < MPI_THREAD_MULTIPLE )
+    throw std::runtime_error("ProgressEngine requires MPI_THREAD_MULTIPLE");
+
+  bool expected = false;
+  if( not engine_active.compare_exchange_strong( expected, true ) )
+    throw std::runtime_error("Only one ProgressEngine may run per process");
+
+  thread_ = std::thread( &ProgressEngine::run, this, core );
+
+}
+
+ProgressEngine::~ProgressEngine() noexcept {
+
+  stop_.store( true );
+  {
+    std::lock_guard<std::mutex> lock( mutex_ );
+    cv_.notify_one();
+  }
+  thread_.join();
+  engine_active.store( false );
+
+}
+
+void ProgressEngine::submit( Request& req ) {
+
+  if( not req.state_ ) return;
+  req.state_->delegated.store( true, std::memory_order_release );
+
+  // The push and the load of sleeping_ pair with the store of sleeping_ and
+  // the load of head_ in run(). All four must be seq_cst: a release push
+  // could be reordered after the load, and both threads could then miss
+  // each other (lost wakeup)
+  auto* node = new Node{ req.state_, head_.load( std::memory_order_relaxed ) };
+  while( not head_.compare_exchange_weak( node->next, node,
+    std::memory_order_seq_cst, std::memory_order_relaxed ) );
+
+  if( sleeping_.load() ) {
+    std::lock_guard<std::mutex> lock( mutex_ );
+    cv_.notify_one();
+  }
+
+}
+
+void ProgressEngine::run( int64_t core ) {
+
+#ifdef __linux__
+  if( core >= 0 ) {
+    cpu_set_t cpuset;
+    CPU_ZERO( &cpuset );
+    CPU_SET( core, &cpuset );
+    pthread_setaffinity_np( pthread_self(), sizeof(cpu_set_t), &cpuset );
+  }
+#endif
+
+  std::vector< std::shared_ptr<detail::RequestState> > inflight;
+
+  while( true ) {
+
+    // Drain the submission stack
+    Node* node = head_.exchange( nullptr, std::memory_order_acquire );
+    while( node ) {
+      inflight.emplace_back( std::move(node->state) );
+      auto* next = node->next;
+      delete node;
+      node = next;
+    }
+
+    // Progress outstanding requests
+    for( auto it = inflight.begin(); it != inflight.end(); ) {
+      if( (*it)->test_handles() ) it = inflight.erase( it );
+      else                        ++it;
+    }
+
+    if( inflight.size() ) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // Nothing in flight: exit or sleep until a submission arrives
+    if( stop_.load() and not head_.load() ) break;
+
+    std::unique_lock<std::mutex> lock( mutex_ );
+    sleeping_.store( true );
+    cv_.wait( lock, [&]() { return stop_.load() or head_.load(); } );
+    sleeping_.store( false );
+
+  }
+
+}
+
+}
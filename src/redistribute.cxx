@@ -0,0 +1,164 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/redistribute.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace blacspp {
+
+namespace {
+
+  /// Run of global indices [start, start+length) owned by a fixed pair of processes
+  struct OwnerRun {
+    int64_t src_proc, dst_proc;
+    int64_t src_local, dst_local;
+    int64_t length;
+  };
+
+  /// Split one dimension into runs over which neither distribution changes owner
+  std::vector<OwnerRun> owner_runs( int64_t n, 
+    int64_t nb_a, int64_t src_a, int64_t np_a,
+    int64_t nb_b, int64_t src_b, int64_t np_b ) {
+
+    auto owner = []( int64_t i, int64_t nb, int64_t isrc, int64_t np ) {
+      return ( i / nb + isrc ) % np;
+    };
+    auto local = []( int64_t i, int64_t nb, int64_t np ) {
+      return ( i / (nb*np) ) * nb + i % nb;
+    };
+
+    std::vector<OwnerRun> runs;
+    for( int64_t i = 0; i < n; ) {
+      const int64_t end = std::min( { n, (i / nb_a + 1) * nb_a, 
+                                         (i / nb_b + 1) * nb_b } );
+      runs.push_back( { owner( i, nb_a, src_a, np_a ), 
+                        owner( i, nb_b, src_b, np_b ),
+                        local( i, nb_a, np_a ), local( i, nb_b, np_b ),
+                        end - i } );
+      i = end;
+    }
+    return runs;
+
+  }
+
+}
+
+RedistributePlan::RedistributePlan( MPI_Comm comm, const Grid& src,
+  const BlockCyclic& a, const Grid& dst, const BlockCyclic& b ) {
+
+  if( a.M != b.M or a.N != b.N )
+    throw std::runtime_error("RedistributePlan: distributions must describe the same matrix");
+  if( a.MB <= 0 or a.NB <= 0 or b.MB <= 0 or b.NB <= 0 )
+    throw std::runtime_error("RedistributePlan: blocking factors must be positive");
+
+  comm_ = std::shared_ptr<MPI_Comm>( new MPI_Comm, []( MPI_Comm* c ) {
+    MPI_Comm_free( c );
+    delete c;
+  });
+  MPI_Comm_dup( comm, comm_.get() );
+
+  mpi_info info( *comm_ );
+
+  // Coordinates and shapes of both grids on every process (-1 outside)
+  const bool in_src = src.is_valid(), in_dst = dst.is_valid();
+  int64_t mine[8] = {
+    in_src ? src.ipr() : -1, in_src ? src.ipc() : -1,
+    in_src ? src.npr() : -1, in_src ? src.npc() : -1,
+    in_dst ? dst.ipr() : -1, in_dst ? dst.ipc() : -1,
+    in_dst ? dst.npr() : -1, in_dst ? dst.npc() : -1
+  };
+  std::vector<int64_t> coords( 8 * info.size() );
+  MPI_Allgather( mine, 8, MPI_INT64_T, coords.data(), 8, MPI_INT64_T, *comm_ );
+
+  int64_t src_npc = 0, dst_npc = 0;
+  for( int64_t r = 0; r < info.size(); ++r ) {
+    src_npr_ = std::max( src_npr_, coords[8*r+2] );
+    src_npc  = std::max( src_npc,  coords[8*r+3] );
+    dst_npr_ = std::max( dst_npr_, coords[8*r+6] );
+    dst_npc  = std::max( dst_npc,  coords[8*r+7] );
+  }
+  if( src_npr_ < 1 or dst_npr_ < 1 )
+    throw std::runtime_error("RedistributePlan: both grids must hold a process of comm");
+
+  src_ranks_.assign( src_npr_ * src_npc, -1 );
+  dst_ranks_.assign( dst_npr_ * dst_npc, -1 );
+  for( int64_t r = 0; r < info.size(); ++r ) {
+    if( coords[8*r] >= 0 ) 
+      src_ranks_[ coords[8*r]   + coords[8*r+1] * src_npr_ ] = r;
+    if( coords[8*r+4] >= 0 ) 
+      dst_ranks_[ coords[8*r+4] + coords[8*r+5] * dst_npr_ ] = r;
+  }
+
+  // Consecutive runs to the same partner are merged when they are also
+  // contiguous locally on both sides
+  auto append = []( std::vector<Run>& runs, const OwnerRun& o ) {
+    if( runs.size() and 
+        runs.back().src_local + runs.back().length == o.src_local and
+        runs.back().dst_local + runs.back().length == o.dst_local )
+      runs.back().length += o.length;
+    else runs.push_back( { o.src_local, o.dst_local, o.length } );
+  };
+
+  const auto row_runs = owner_runs( a.M, a.MB, a.RSRC, src_npr_, 
+                                         b.MB, b.RSRC, dst_npr_ );
+  const auto col_runs = owner_runs( a.N, a.NB, a.CSRC, src_npc,
+                                         b.NB, b.CSRC, dst_npc );
+
+  if( in_src ) {
+    send_rows_.resize( dst_npr_ );
+    send_cols_.resize( dst_npc  );
+    for( const auto& o : row_runs ) if( o.src_proc == src.ipr() )
+      append( send_rows_[o.dst_proc], o );
+    for( const auto& o : col_runs ) if( o.src_proc == src.ipc() )
+      append( send_cols_[o.dst_proc], o );
+  }
+
+  if( in_dst ) {
+    recv_rows_.resize( src_npr_ );
+    recv_cols_.resize( src_npc  );
+    for( const auto& o : row_runs ) if( o.dst_proc == dst.ipr() )
+      append( recv_rows_[o.src_proc], o );
+    for( const auto& o : col_runs ) if( o.dst_proc == dst.ipc() )
+      append( recv_cols_[o.src_proc], o );
+  }
+
+}
+
+int64_t RedistributePlan::send_count() const noexcept {
+
+  int me;
+  MPI_Comm_rank( *comm_, &me );
+
+  int64_t n = 0;
+  for( size_t pc = 0; pc < send_cols_.size(); ++pc )
+  for( size_t pr = 0; pr < send_rows_.size(); ++pr ) {
+    if( dst_ranks_[ pr + pc*dst_npr_ ] == me ) continue;
+    int64_t m = 0, k = 0;
+    for( const auto& r : send_rows_[pr] ) m += r.length;
+    for( const auto& c : send_cols_[pc] ) k += c.length;
+    n += m * k;
+  }
+  return n;
+
+}
+
+int64_t RedistributePlan::partner_count() const noexcept {
+
+  int me;
+  MPI_Comm_rank( *comm_, &me );
+
+  int64_t n = 0;
+  for( size_t pc = 0; pc < send_cols_.size(); ++pc )
+  for( size_t pr = 0; pr < send_rows_.size(); ++pr )
+    n += dst_ranks_[ pr + pc*dst_npr_ ] != me and 
+         send_rows_[pr].size() and send_cols_[pc].size();
+  return n;
+
+}
+
+}
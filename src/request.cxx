@@ -0,0 +1,80 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/request.hpp>
+#include <thread>
+
+namespace blacspp {
+
+namespace detail {
+
+RequestState::RequestState( std::vector<MPI_Request>&& _handles,
+  RequestContinuation&& _next ) :
+  handles( std::move(_handles) ), next( std::move(_next) ) { }
+
+bool RequestState::test_handles() {
+
+  internal::mpi_int flag = 1;
+  while( true ) {
+
+    if( handles.size() )
+      MPI_Testall( handles.size(), handles.data(), &flag, MPI_STATUSES_IGNORE );
+
+    if( not flag ) return false;
+    if( not next or not next( handles ) ) break;
+
+  }
+
+  complete.store( true, std::memory_order_release );
+  return true;
+
+}
+
+void RequestState::wait_handles() {
+
+  do {
+    if( handles.size() )
+      MPI_Waitall( handles.size(), handles.data(), MPI_STATUSES_IGNORE );
+  } while( next and next( handles ) );
+
+  complete.store( true, std::memory_order_release );
+
+}
+
+}
+
+Request::Request( std::vector<MPI_Request> handles ) :
+  state_( std::make_shared<detail::RequestState>( std::move(handles) ) ) { }
+
+Request::Request( std::vector<MPI_Request> handles,
+  detail::RequestContinuation next ) :
+  state_( std::make_shared<detail::RequestState>( std::move(handles),
+                                                  std::move(next) ) ) { }
+
+bool Request::test() {
+
+  if( not state_ ) return true;
+  if( state_->complete.load( std::memory_order_acquire ) ) return true;
+  if( state_->delegated.load( std::memory_order_acquire ) ) return false;
+
+  return state_->test_handles();
+
+}
+
+void Request::wait() {
+
+  if( not state_ ) return;
+
+  if( state_->delegated.load( std::memory_order_acquire ) ) {
+    while( not state_->complete.load( std::memory_order_acquire ) )
+      std::this_thread::yield();
+  } else if( not state_->complete.load( std::memory_order_acquire ) ) {
+    state_->wait_handles();
+  }
+
+}
+
+}
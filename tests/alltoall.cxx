@@ -0,0 +1,100 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/alltoall.hpp>
+#include <array>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+const std::array< blacspp::Scope, 3 > alltoall_scopes = 
+  { blacspp::Scope::All, blacspp::Scope::Row, blacspp::Scope::Column };
+
+const std::array< blacspp::AlltoallAlgorithm, 3 > alltoall_algorithms = 
+  { blacspp::AlltoallAlgorithm::Auto, blacspp::AlltoallAlgorithm::Pairwise, 
+    blacspp::AlltoallAlgorithm::Bruck };
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Alltoallv", "[alltoall]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  for( auto scope : alltoall_scopes ) 
+  for( auto alg   : alltoall_algorithms ) 
+  for( int64_t scale : { 1, 500 } ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto P  = members.size();
+    const auto me = members.me;
+
+    // p sends ((p + q) % 3) * scale elements to q (possibly zero), 
+    // encoding (p, q, index)
+    auto count = [&]( int64_t p, int64_t q ) { return ((p + q) % 3) * scale; };
+    auto val   = [&]( int64_t p, int64_t q, int64_t i ) {
+      return TestType( p + 10*q + 100*(i % 50) );
+    };
+
+    std::vector< int64_t > scounts( P ), rcounts( P );
+    std::vector< TestType > sbuf;
+    for( int64_t q = 0; q < P; ++q ) {
+      scounts[q] = count( me, q );
+      rcounts[q] = count( q, me );
+      for( int64_t i = 0; i < scounts[q]; ++i ) sbuf.emplace_back( val( me, q, i ) );
+    }
+
+    auto check = [&]( const std::vector< TestType >& rbuf ) {
+      int64_t off = 0;
+      for( int64_t q = 0; q < P; ++q )
+      for( int64_t i = 0; i < rcounts[q]; ++i, ++off ) 
+        CHECK( rbuf[off] == val( q, me, i ) );
+      CHECK( off == int64_t(rbuf.size()) );
+    };
+
+    // Known counts
+    int64_t rtot = 0; for( auto c : rcounts ) rtot += c;
+    std::vector< TestType > rbuf( rtot );
+    blacspp::alltoallv2d( grid, scope, scounts, sbuf.data(), rcounts, 
+                          rbuf.data(), alg );
+    check( rbuf );
+
+    // Count exchange
+    std::vector< int64_t > rc;
+    std::vector< TestType > rb;
+    blacspp::alltoallv2d( grid, scope, scounts, sbuf, rc, rb, alg );
+    CHECK( rc == rcounts );
+    check( rb );
+
+    // Persistent plan
+    blacspp::AlltoallvPlan< TestType > plan( grid, scope, scounts, alg );
+    CHECK( plan.recv_counts() == rcounts );
+    CHECK( plan.send_size() == int64_t(sbuf.size()) );
+    if( alg == blacspp::AlltoallAlgorithm::Auto and P > 2 )
+      CHECK( plan.algorithm() == ( scale * sizeof(TestType) * 2 <= 1024 ?
+        blacspp::AlltoallAlgorithm::Bruck : blacspp::AlltoallAlgorithm::Pairwise ) );
+    for( int rep = 0; rep < 2; ++rep ) {
+      std::vector< TestType > r( plan.recv_size() );
+      plan.execute( sbuf.data(), r.data() );
+      check( r );
+    }
+
+  }
+
+}
+
+TEST_CASE( "Bruck Alltoallv Count Mismatch", "[alltoall]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  const int64_t P = grid.npr() * grid.npc();
+
+  // Every participant sends 2 elements but expects 3 from each
+  std::vector< int64_t > scounts( P, 2 ), rcounts( P, 3 );
+  std::vector< double >  sbuf( 2*P, 1. ), rbuf( 3*P );
+  CHECK_THROWS( blacspp::alltoallv2d( grid, blacspp::Scope::All, scounts, 
+    sbuf.data(), rcounts, rbuf.data(), blacspp::AlltoallAlgorithm::Bruck ) );
+
+}
@@ -7,6 +7,8 @@
 #include <catch2/catch.hpp>
 #include <blacspp/broadcast.hpp>
 #include <blacspp/information.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
@@ -41,7 +43,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "General 2D Broadcast", "[broadcast]" ) {
         blacspp::gebs2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data_send.data(), M );
         for( auto x : data_recv ) CHECK( x == TestType(-1) );
       } else {
-        blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data_recv.data(), M );
+        blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data_recv.data(), M, 0, 0 );
         for( auto x : data_recv ) CHECK( x == TestType(0) );
       }
 
@@ -53,7 +55,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "General 2D Broadcast", "[broadcast]" ) {
         blacspp::gebs2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, M, N, data_send.data(), M );
         for( auto x : data_recv ) CHECK( x == TestType(-1) );
       } else {
-        blacspp::gebr2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, M, N, data_recv.data(), M );
+        blacspp::gebr2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, M, N, data_recv.data(), M, grid.ipr(), 0 );
         for( auto x : data_recv ) CHECK( x == TestType(col_rank) );
       }
 
@@ -65,7 +67,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "General 2D Broadcast", "[broadcast]" ) {
         blacspp::gebs2d( grid, blacspp::Scope::Column, blacspp::Topology::IRing, M, N, data_send.data(), M );
         for( auto x : data_recv ) CHECK( x == TestType(-1) );
       } else {
-        blacspp::gebr2d( grid, blacspp::Scope::Column, blacspp::Topology::IRing, M, N, data_recv.data(), M );
+        blacspp::gebr2d( grid, blacspp::Scope::Column, blacspp::Topology::IRing, M, N, data_recv.data(), M, 0, grid.ipc() );
         for( auto x : data_recv ) CHECK( x == TestType(row_rank) );
       }
 
@@ -87,7 +89,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "General 2D Broadcast", "[broadcast]" ) {
       blacspp::gebs2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data_send, M );
       for( auto x : data_recv ) CHECK( x == TestType(-1) );
     } else {
-      blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data_recv, M );
+      blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data_recv, M, 0, 0 );
       for( auto x : data_recv ) CHECK( x == TestType(0) );
     }
 
@@ -101,7 +103,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "General 2D Broadcast", "[broadcast]" ) {
       blacspp::gebs2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, data_send );
       for( auto x : data_recv ) CHECK( x == TestType(-1) );
     } else {
-      blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, data_recv );
+      blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, data_recv, 0, 0 );
       for( auto x : data_recv ) CHECK( x == TestType(0) );
     }
 
@@ -157,7 +159,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Broadcast", "[broadcast]" ) {
           blacspp::trbs2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, tri, diag, M, N, data_send.data(), M );
           for( auto x : data_recv ) CHECK( x == TestType(-1) );
         } else {
-          blacspp::trbr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, tri, diag, M, N, data_recv.data(), M );
+          blacspp::trbr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, tri, diag, M, N, data_recv.data(), M, 0, 0 );
           check_triangle( tri, diag, data_recv, 0 );
         }
 
@@ -175,7 +177,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Broadcast", "[broadcast]" ) {
           blacspp::trbs2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, tri, diag, M, N, data_send.data(), M );
           for( auto x : data_recv ) CHECK( x == TestType(-1) );
         } else {
-          blacspp::trbr2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, tri, diag, M, N, data_recv.data(), M );
+          blacspp::trbr2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, tri, diag, M, N, data_recv.data(), M, grid.ipr(), 0 );
           check_triangle( tri, diag, data_recv, col_rank );
         }
 
@@ -194,7 +196,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Broadcast", "[broadcast]" ) {
           blacspp::trbs2d( grid, blacspp::Scope::Column, blacspp::Topology::IRing, tri, diag, M, N, data_send.data(), M );
           for( auto x : data_recv ) CHECK( x == TestType(-1) );
         } else {
-          blacspp::trbr2d( grid, blacspp::Scope::Column, blacspp::Topology::IRing, tri, diag, M, N, data_recv.data(), M );
+          blacspp::trbr2d( grid, blacspp::Scope::Column, blacspp::Topology::IRing, tri, diag, M, N, data_recv.data(), M, 0, grid.ipc() );
           check_triangle( tri, diag, data_recv, row_rank );
         }
 
@@ -217,7 +219,7 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Broadcast", "[broadcast]" ) {
         blacspp::trbs2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, tri, diag, M, N, data_send, M );
         for( auto x : data_recv ) CHECK( x == TestType(-1) );
       } else {
-        blacspp::trbr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, tri, diag, M, N, data_recv, M );
+        blacspp::trbr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, tri, diag, M, N, data_recv, M, 0, 0 );
         check_triangle( tri, diag, data_recv, 0 );
       }
 
@@ -229,3 +231,28 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Broadcast", "[broadcast]" ) {
   for( auto x : data_send ) CHECK( x == TestType(mpi.rank()) );
 
 }
+
+
+TEMPLATE_TEST_CASE( "Non-BLACS Type 2D Broadcast", "[broadcast]", 
+  int64_t, uint16_t, std::size_t ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M(3), N(2), LDA(4);
+  auto val = []( int64_t r, int64_t i ) { return TestType( (r+1) * 1000 + i ); };
+
+  std::vector< TestType > data( LDA*N, TestType(0) );
+
+  if( grid.ipc() == 0 ) {
+    for( int64_t i = 0; i < LDA*N; ++i ) data[i] = val( grid.ipr(), i );
+    blacspp::gebs2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, M, N, 
+                     data.data(), LDA );
+  } else {
+    blacspp::gebr2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, M, N, 
+                     data.data(), LDA, grid.ipr(), 0 );
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i ) 
+      CHECK( data[i + j*LDA] == (i < M ? val( grid.ipr(), i + j*LDA ) : TestType(0)) );
+  }
+
+}
@@ -0,0 +1,121 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/collectives.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+const std::array< blacspp::Scope, 3 > scopes = 
+  { blacspp::Scope::All, blacspp::Scope::Row, blacspp::Scope::Column };
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Allgather", "[collectives]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const int64_t M(3), LDA(4), LDB(5);
+
+  for( auto scope : scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto P = members.size();
+
+    // Variable block sizes: participant p contributes p+1 columns
+    std::vector<int64_t> N( P );
+    for( int64_t p = 0; p < P; ++p ) N[p] = p + 1;
+    const auto ntot = P * (P+1) / 2;
+    const auto nloc = N[members.me];
+
+    std::vector< TestType > A( LDA*nloc, TestType(-1) );
+    for( int64_t j = 0; j < nloc; ++j )
+    for( int64_t i = 0; i < M;    ++i ) A[i + j*LDA] = TestType(mpi.rank()*100 + i + 10*j);
+
+    std::vector< TestType > B( LDB*ntot, TestType(-1) );
+    blacspp::allgather2d( grid, scope, M, N.data(), A.data(), LDA, B.data(), LDB );
+
+    int64_t col = 0;
+    for( int64_t p = 0; p < P; ++p )
+    for( int64_t j = 0; j < N[p]; ++j, ++col )
+    for( int64_t i = 0; i < LDB;  ++i ) {
+      if( i < M ) CHECK( B[i + col*LDB] == TestType(members.ranks[p]*100 + i + 10*j) );
+      else        CHECK( B[i + col*LDB] == TestType(-1) );
+    }
+
+    // Uniform container interface
+    std::vector< TestType > a( 4, TestType(mpi.rank()) ), b( 4*P );
+    blacspp::allgather2d( grid, scope, a, b );
+    for( int64_t p = 0; p < P; ++p )
+    for( int64_t i = 0; i < 4; ++i ) CHECK( b[i + 4*p] == TestType(members.ranks[p]) );
+
+    // Variable container interface
+    std::vector< TestType > c( N[members.me], TestType(mpi.rank()) ), d( ntot );
+    blacspp::allgather2d( grid, scope, N, c, d );
+    col = 0;
+    for( int64_t p = 0; p < P; ++p )
+    for( int64_t j = 0; j < N[p]; ++j ) CHECK( d[col++] == TestType(members.ranks[p]) );
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Reduce-Scatter", "[collectives]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const int64_t M(3), LDA(4), LDB(5);
+
+  for( auto scope : scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto P = members.size();
+
+    std::vector<int64_t> N( P );
+    for( int64_t p = 0; p < P; ++p ) N[p] = P - p;
+    int64_t ntot = 0;
+    for( auto n : N ) ntot += n;
+
+    int64_t rank_sum = 0;
+    for( auto r : members.ranks ) rank_sum += r;
+
+    // A(i,j) = rank + i + j (global column j)
+    std::vector< TestType > A( LDA*ntot, TestType(-1) );
+    for( int64_t j = 0; j < ntot; ++j )
+    for( int64_t i = 0; i < M;    ++i ) A[i + j*LDA] = TestType(mpi.rank() + i + j);
+    auto A_copy = A;
+
+    const auto nloc = N[members.me];
+    int64_t off = 0;
+    for( int64_t p = 0; p < members.me; ++p ) off += N[p];
+
+    std::vector< TestType > B( LDB*nloc, TestType(-1) );
+    blacspp::reduce_scatter2d( grid, scope, M, N.data(), A.data(), LDA, B.data(), LDB );
+
+    for( int64_t j = 0; j < nloc; ++j )
+    for( int64_t i = 0; i < LDB;  ++i ) {
+      if( i < M ) CHECK( B[i + j*LDB] == TestType(rank_sum + P*(i + off + j)) );
+      else        CHECK( B[i + j*LDB] == TestType(-1) );
+    }
+    CHECK( A == A_copy );
+
+    // Uniform container interface
+    std::vector< TestType > a( 2*P, TestType(1) ), b( 2, TestType(0) );
+    blacspp::reduce_scatter2d( grid, scope, a, b );
+    for( auto x : b ) CHECK( x == TestType(P) );
+
+    // Variable container interface
+    std::vector< TestType > c( ntot, TestType(2) ), d( nloc, TestType(0) );
+    blacspp::reduce_scatter2d( grid, scope, N, c, d );
+    for( auto x : d ) CHECK( x == TestType(2*P) );
+
+  }
+
+}
@@ -0,0 +1,118 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/combine.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+const blacspp::Scope combine_scopes[] = { blacspp::Scope::All, blacspp::Scope::Row, 
+                                          blacspp::Scope::Column };
+
+// Row-major grid indices of the participants of a scope
+std::vector<int64_t> combine_participants( const blacspp::Grid& grid, 
+                                           blacspp::Scope scope ) {
+  std::vector<int64_t> ids;
+  for( int64_t pr = 0; pr < grid.npr(); ++pr )
+  for( int64_t pc = 0; pc < grid.npc(); ++pc ) {
+    if( scope == blacspp::Scope::Row    and pr != grid.ipr() ) continue;
+    if( scope == blacspp::Scope::Column and pc != grid.ipc() ) continue;
+    ids.push_back( pr * grid.npc() + pc );
+  }
+  return ids;
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "General 2D Sum", "[combine]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+
+  for( auto scope : combine_scopes ) {
+
+    {
+      const auto ids = combine_participants( grid, scope );
+      const int64_t M(3), N(2), LDA(4);
+
+      std::vector< TestType > A( LDA*N, TestType(-1) );
+      for( int64_t j = 0; j < N; ++j )
+      for( int64_t i = 0; i < M; ++i ) A[i + j*LDA] = TestType( me + i + j );
+
+      blacspp::gsum2d( grid, scope, blacspp::Topology::IRing, M, N, A.data(), LDA );
+
+      int64_t rank_sum = 0;
+      for( auto r : ids ) rank_sum += r;
+
+      for( int64_t j = 0; j < N;   ++j )
+      for( int64_t i = 0; i < LDA; ++i ) 
+        CHECK( A[i + j*LDA] == ( i < M ? 
+          TestType( rank_sum + ids.size() * (i + j) ) : TestType(-1) ) );
+    }
+
+  }
+
+}
+
+TEMPLATE_TEST_CASE( "Native Integer Combines", "[combine]", 
+  int8_t, uint8_t, int32_t, int64_t ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+
+  for( auto scope : combine_scopes ) {
+
+    const auto ids = combine_participants( grid, scope );
+    const int64_t M(3), N(2), LDA(4);
+
+    // Odd values are negated for signed types, the extrema are by absolute
+    // value (values of equal magnitude are equal, BLACS does not specify ties)
+    auto val = [&]( int64_t r, int64_t i ) { 
+      const int64_t x = (r * 37 + i) % 100;
+      return TestType( std::is_signed<TestType>::value and x % 2 ? -x : x ); 
+    };
+    auto mag = []( TestType x ) { return std::abs( int64_t(x) ); };
+
+    std::vector< TestType > S( LDA*N, TestType(-1) ), X( S ), Y( S );
+    for( int64_t i = 0; i < LDA*N; ++i ) 
+    if( i % LDA < M ) S[i] = X[i] = Y[i] = val( me, i );
+
+    blacspp::gsum2d( grid, scope, blacspp::Topology::IRing, M, N, S.data(), LDA );
+    blacspp::gamx2d( grid, scope, blacspp::Topology::IRing, M, N, X.data(), LDA );
+    blacspp::gamn2d( grid, scope, blacspp::Topology::IRing, M, N, Y.data(), LDA );
+
+    for( int64_t i = 0; i < LDA*N; ++i ) {
+      if( i % LDA >= M ) {
+        CHECK( S[i] == TestType(-1) );
+        CHECK( X[i] == TestType(-1) );
+        CHECK( Y[i] == TestType(-1) );
+        continue;
+      }
+      TestType sum = 0, mx = val( ids[0], i ), mn = mx;
+      for( auto r : ids ) {
+        sum = TestType( sum + val( r, i ) );
+        const auto v = val( r, i );
+        if( mag(v) > mag(mx) ) mx = v;
+        if( mag(v) < mag(mn) ) mn = v;
+      }
+      CHECK( S[i] == sum );
+      CHECK( X[i] == mx  );
+      CHECK( Y[i] == mn  );
+    }
+
+    // Container interface with a destination-less sum
+    std::vector< TestType > V( 5, TestType(1) );
+    blacspp::gsum2d( grid, scope, blacspp::Topology::IRing, V );
+    for( auto v : V ) CHECK( v == TestType( ids.size() ) );
+
+  }
+
+}
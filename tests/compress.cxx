@@ -0,0 +1,193 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/compress.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <cmath>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+
+TEST_CASE( "Compression Codec", "[compress]" ) {
+
+  using blacspp::detail::compress;
+  using blacspp::detail::decompress;
+
+  blacspp::CompressionOptions opts;
+  opts.threshold = 0;
+  std::vector<uint8_t> msg;
+
+  SECTION( "Monotone Integers" ) {
+
+    std::vector<int64_t> A( 1000 ), B( 1000 );
+    for( int64_t i = 0; i < 1000; ++i ) A[i] = 1000000 + 3*i;
+
+    auto stats = compress( A.data(), A.size(), sizeof(int64_t), true, opts, msg );
+    CHECK( stats.compressed );
+    CHECK( stats.raw_bytes  == 8000 );
+    CHECK( stats.wire_bytes == int64_t(msg.size()) );
+    CHECK( stats.ratio() > 20. );
+
+    decompress( msg.data(), msg.size(), B.data(), B.size(), sizeof(int64_t) );
+    CHECK( A == B );
+
+  }
+
+  SECTION( "Sparse Doubles" ) {
+
+    std::vector<double> A( 1000, 0. ), B( 1000 );
+    for( int64_t i = 0; i < 1000; i += 37 ) A[i] = std::sqrt( double(i) );
+
+    auto stats = compress( A.data(), A.size(), sizeof(double), false, opts, msg );
+    CHECK( stats.compressed );
+    CHECK( stats.ratio() > 4. );
+
+    decompress( msg.data(), msg.size(), B.data(), B.size(), sizeof(double) );
+    CHECK( A == B );
+
+  }
+
+  SECTION( "Incompressible Fallback" ) {
+
+    std::vector<uint8_t> A( 1000 ), B( 1000 );
+    uint32_t x = 12345;
+    for( auto& a : A ) { x = x * 1664525u + 1013904223u; a = x >> 24; }
+
+    auto stats = compress( A.data(), A.size(), 1, true, opts, msg );
+    CHECK( not stats.compressed );
+    CHECK( stats.wire_bytes > int64_t(A.size()) );
+    CHECK( stats.ratio() < 1. );
+
+    decompress( msg.data(), msg.size(), B.data(), B.size(), 1 );
+    CHECK( A == B );
+
+  }
+
+  SECTION( "Below Threshold" ) {
+
+    std::vector<int32_t> A( 100, 7 ), B( 100 );
+    opts.threshold = 1024;
+
+    auto stats = compress( A.data(), A.size(), sizeof(int32_t), true, opts, msg );
+    CHECK( not stats.compressed );
+
+    decompress( msg.data(), msg.size(), B.data(), B.size(), sizeof(int32_t) );
+    CHECK( A == B );
+
+  }
+
+  SECTION( "Size Mismatch" ) {
+
+    std::vector<int32_t> A( 100, 7 );
+    compress( A.data(), A.size(), sizeof(int32_t), true, opts, msg );
+    CHECK_THROWS( decompress( msg.data(), msg.size(), A.data(), 50, sizeof(int32_t) ) );
+
+  }
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "Compressed Transfers", "[compress]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+
+  // Mostly-zero data so the codec engages
+  const int64_t M(200), N(5), LDA(210);
+  auto val = []( int64_t p, int64_t i ) { 
+    return TestType( i % 50 == 0 ? p + i + 1 : 0 ); 
+  };
+
+  std::vector< TestType > A( LDA*N );
+  for( int64_t i = 0; i < LDA*N; ++i ) A[i] = val( me, i );
+
+  blacspp::CompressionOptions opts;
+  opts.threshold = 128;
+
+  std::vector< TestType > B( LDA*N, TestType(-1) );
+  blacspp::CompressionStats stats;
+  if( me % 2 == 0 ) {
+    stats = blacspp::gesd2d_compressed( grid, M, N, A.data(), LDA, 
+      next / grid.npc(), next % grid.npc(), opts );
+    blacspp::gerv2d_compressed( grid, M, N, B.data(), LDA, 
+      prev / grid.npc(), prev % grid.npc() );
+  } else {
+    blacspp::gerv2d_compressed( grid, M, N, B.data(), LDA, 
+      prev / grid.npc(), prev % grid.npc() );
+    stats = blacspp::gesd2d_compressed( grid, M, N, A.data(), LDA, 
+      next / grid.npc(), next % grid.npc(), opts );
+  }
+
+  CHECK( stats.compressed );
+  CHECK( stats.raw_bytes == int64_t(M*N*sizeof(TestType)) );
+  CHECK( stats.ratio() > 1. );
+
+  for( int64_t j = 0; j < N;   ++j )
+  for( int64_t i = 0; i < LDA; ++i ) {
+    if( i < M ) CHECK( B[i + j*LDA] == val( prev, i + j*LDA ) );
+    else        CHECK( B[i + j*LDA] == TestType(-1) );
+  }
+
+  // Broadcast along the process column
+  std::vector< TestType > C( LDA*N, TestType(-1) );
+  if( grid.ipr() == 0 )
+    blacspp::gebs2d_compressed( grid, blacspp::Scope::Column, M, N, A.data(), 
+      LDA, opts );
+  else {
+    blacspp::gebr2d_compressed( grid, blacspp::Scope::Column, M, N, C.data(), 
+      LDA, 0, grid.ipc() );
+    const auto root = grid.ipc();
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) 
+      CHECK( C[i + j*LDA] == val( root, i + j*LDA ) );
+  }
+
+  if( grid.npc() > 1 )
+    CHECK_THROWS( blacspp::gebr2d_compressed( grid, blacspp::Scope::Column, M, N, 
+      C.data(), LDA, 0, (grid.ipc() + 1) % grid.npc() ) );
+
+}
+
+TEST_CASE( "Compressed Transfers Beside Plain Traffic", "[compress]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+  const auto nr = next / grid.npc(), nc = next % grid.npc();
+  const auto pr = prev / grid.npc(), pc = prev % grid.npc();
+
+  blacspp::CompressionOptions opts;
+  opts.threshold = 16;
+
+  // Every process posts a plain send before its compressed send to the same
+  // peer: the compressed recieve must not pick up the plain message
+  std::vector<double> plain_send( 8, double(me) ), plain_recv( 8, -1. );
+  std::vector<double> A( 64, 0. ), B( 64, -1. );
+  A[0] = me + 1.;
+
+  auto sreq = blacspp::igesd2d( grid, plain_send, nr, nc );
+  if( me % 2 == 0 ) {
+    blacspp::gesd2d_compressed( grid, 64, 1, A.data(), 64, nr, nc, opts );
+    blacspp::gerv2d_compressed( grid, 64, 1, B.data(), 64, pr, pc );
+  } else {
+    blacspp::gerv2d_compressed( grid, 64, 1, B.data(), 64, pr, pc );
+    blacspp::gesd2d_compressed( grid, 64, 1, A.data(), 64, nr, nc, opts );
+  }
+  blacspp::igerv2d( grid, plain_recv, pr, pc ).wait();
+  sreq.wait();
+
+  CHECK( B[0] == prev + 1. );
+  for( int64_t i = 1; i < 64; ++i ) CHECK( B[i] == 0. );
+  for( auto x : plain_recv ) CHECK( x == double(prev) );
+
+}
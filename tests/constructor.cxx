@@ -6,6 +6,10 @@
  */
 #include <catch2/catch.hpp>
 #include <blacspp/grid.hpp>
+#include <blacspp/information.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/wrappers/support.hpp>
+#include <algorithm>
 #include <iostream>
 
 
@@ -147,3 +151,294 @@ TEST_CASE( "Move Constructor", "[constructor]" ) {
   CHECK( context == grid2.context() );
 
 }
+
+TEST_CASE( "Adopt BLACS Context", "[constructor]" ) {
+
+  blacspp::mpi_info mpi(MPI_COMM_WORLD);
+
+  // Externally created (col-major) BLACS grid
+  int64_t npr = mpi.size() > 1 ? 2 : 1;
+  if( mpi.size() % npr ) npr = 1;
+  const int64_t npc = mpi.size() / npr;
+
+  const auto handle  = blacspp::wrappers::blacs_from_sys( MPI_COMM_WORLD );
+  const auto context = blacspp::wrappers::grid_init( handle, "C", npr, npc );
+
+  {
+    auto grid = blacspp::Grid::adopt( context );
+
+    REQUIRE( grid.is_valid() );
+    CHECK( grid.context() == context );
+    CHECK( grid.npr() == npr );
+    CHECK( grid.npc() == npc );
+    CHECK( grid.ipr() == mpi.rank() % npr );
+    CHECK( grid.ipc() == mpi.rank() / npr );
+
+    // Coordinate table is consistent with the adopted communicator
+    int rank;
+    MPI_Comm_rank( grid.comm(), &rank );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == rank );
+
+    // BLACS traffic through the adopted context
+    std::vector<double> x( 3, -1. );
+    if( grid.ipr() == 0 and grid.ipc() == 0 ) {
+      std::vector<double> y( 3, 42. );
+      for( int64_t pc = 0; pc < npc; ++pc )
+      for( int64_t pr = 0; pr < npr; ++pr )
+        if( pr or pc ) blacspp::gesd2d( grid, y, pr, pc );
+    } else {
+      blacspp::gerv2d( grid, x, 0, 0 );
+      for( auto v : x ) CHECK( v == 42. );
+    }
+  }
+
+  // The context outlives the adopted grid
+  auto dim = blacspp::wrappers::grid_info( context );
+  CHECK( dim.np_row == npr );
+  CHECK( dim.np_col == npc );
+
+  blacspp::wrappers::grid_exit( context );
+  blacspp::wrappers::free_sys_handle( handle );
+
+  CHECK( not blacspp::Grid::adopt( -1 ).is_valid() );
+  CHECK_THROWS( blacspp::Grid::adopt( -1 ).comm_rank( 0, 0 ) );
+  CHECK_THROWS( blacspp::Grid().comm_rank( 0, 0 ) );
+
+}
+
+TEST_CASE( "Adopt BLACS Subgrid", "[constructor]" ) {
+
+  blacspp::mpi_info mpi(MPI_COMM_WORLD);
+
+  // Externally created 1 x n grid over all but rank 0 (reversed)
+  const int64_t n = std::max( mpi.size() - 1, int64_t(1) );
+  std::vector<int64_t> map( n );
+  for( int64_t i = 0; i < n; ++i ) map[i] = mpi.size() - 1 - i;
+
+  const auto handle  = blacspp::wrappers::blacs_from_sys( MPI_COMM_WORLD );
+  const auto context = blacspp::wrappers::grid_map( handle, map.data(), 1, 1, n );
+  const bool member  = mpi.size() == 1 or mpi.rank() > 0;
+
+  // Only the grid processes call adopt
+  if( member ) {
+
+    auto grid = blacspp::Grid::adopt( context );
+    REQUIRE( grid.is_valid() );
+    CHECK( grid.npr() == 1 );
+    CHECK( grid.npc() == n );
+    CHECK( grid.ipc() == (mpi.size() == 1 ? 0 : mpi.size() - 1 - mpi.rank()) );
+
+    // comm() holds exactly the grid processes
+    blacspp::mpi_info sub( grid.comm() );
+    CHECK( sub.size() == n );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == sub.rank() );
+
+    int64_t val = grid.ipc(), sum;
+    MPI_Allreduce( &val, &sum, 1, MPI_INT64_T, MPI_SUM, grid.comm() );
+    CHECK( sum == n * (n-1) / 2 );
+
+    blacspp::wrappers::grid_exit( context );
+
+  } else CHECK( context < 0 );
+
+  blacspp::wrappers::free_sys_handle( handle );
+
+}
+
+TEST_CASE( "Grid From Cartesian Communicator", "[constructor]" ) {
+
+  blacspp::mpi_info mpi(MPI_COMM_WORLD);
+
+  int dims[2] = {0, 0}, periods[2] = {0, 0};
+  MPI_Dims_create( mpi.size(), 2, dims );
+
+  MPI_Comm cart;
+  MPI_Cart_create( MPI_COMM_WORLD, 2, dims, periods, 0, &cart );
+
+  {
+    auto grid = blacspp::Grid::from_cart( cart );
+
+    int coords[2], rank;
+    MPI_Comm_rank( cart, &rank );
+    MPI_Cart_coords( cart, rank, 2, coords );
+
+    REQUIRE( grid.is_valid() );
+    CHECK( grid.comm() == cart );
+    CHECK( grid.npr() == dims[0] );
+    CHECK( grid.npc() == dims[1] );
+    CHECK( grid.ipr() == coords[0] );
+    CHECK( grid.ipc() == coords[1] );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == rank );
+  }
+
+  MPI_Comm_free( &cart );
+
+  CHECK( not blacspp::Grid::from_cart( MPI_COMM_NULL ).is_valid() );
+  CHECK_THROWS( blacspp::Grid::from_cart( MPI_COMM_WORLD ) );
+
+}
+
+TEST_CASE( "Reordered Cartesian Grid", "[constructor]" ) {
+
+  blacspp::mpi_info mpi(MPI_COMM_WORLD);
+
+  int dims[2] = {0, 0};
+  MPI_Dims_create( mpi.size(), 2, dims );
+
+  SECTION( "Full" ) {
+
+    auto grid = blacspp::Grid::cartesian( MPI_COMM_WORLD, dims[0], dims[1], true );
+    REQUIRE( grid.is_valid() );
+
+    int topo, rank, coords[2], cdims[2], periods[2];
+    MPI_Topo_test( grid.comm(), &topo );
+    REQUIRE( topo == MPI_CART );
+    MPI_Comm_rank( grid.comm(), &rank );
+    MPI_Cart_get( grid.comm(), 2, cdims, periods, coords );
+
+    CHECK( periods[0] );
+    CHECK( periods[1] );
+    CHECK( grid.npr() == dims[0] );
+    CHECK( grid.npc() == dims[1] );
+    CHECK( grid.ipr() == coords[0] );
+    CHECK( grid.ipc() == coords[1] );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == rank );
+
+    // Cartesian neighbours are grid neighbours
+    int src, dst;
+    MPI_Cart_shift( grid.comm(), 1, 1, &src, &dst );
+    CHECK( dst == grid.comm_rank( grid.ipr(), (grid.ipc() + 1) % grid.npc() ) );
+
+  }
+
+  SECTION( "Subset" ) {
+
+    if( mpi.size() > 1 ) {
+      auto grid = blacspp::Grid::cartesian( MPI_COMM_WORLD, mpi.size() - 1, 1 );
+      int in_grid = grid.is_valid(), count;
+      MPI_Allreduce( &in_grid, &count, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
+      CHECK( count == mpi.size() - 1 );
+      if( grid.is_valid() ) CHECK( grid.npr() == mpi.size() - 1 );
+    }
+
+    CHECK_THROWS( blacspp::Grid::cartesian( MPI_COMM_WORLD, mpi.size() + 1, 1 ) );
+
+  }
+
+}
+
+TEST_CASE( "Batched Grid Creation", "[constructor]" ) {
+
+  blacspp::mpi_info mpi(MPI_COMM_WORLD);
+  blacspp::Grid full = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  const auto npr = full.npr(), npc = full.npc();
+
+  // Full grid, its row and column subgrids and the first half of the ranks
+  std::vector<blacspp::GridSpec> specs;
+  specs.emplace_back( npr, npc );
+  for( int64_t pr = 0; pr < npr; ++pr ) {
+    std::vector<int64_t> map( npc );
+    for( int64_t pc = 0; pc < npc; ++pc ) map[pc] = pr*npc + pc;
+    specs.emplace_back( 1, npc, map );
+  }
+  for( int64_t pc = 0; pc < npc; ++pc ) {
+    std::vector<int64_t> map( npr );
+    for( int64_t pr = 0; pr < npr; ++pr ) map[pr] = pr*npc + pc;
+    specs.emplace_back( npr, 1, map );
+  }
+  const int64_t nhalf = std::max( mpi.size() / 2, int64_t(1) );
+  specs.emplace_back( nhalf, 1, blacspp::GridOrder::ColMajor );
+
+  auto grids = blacspp::Grid::batch( MPI_COMM_WORLD, specs );
+  REQUIRE( grids.size() == specs.size() );
+
+  const auto& all = grids[0];
+  REQUIRE( all.is_valid() );
+  CHECK( all.npr() == npr );
+  CHECK( all.npc() == npc );
+  CHECK( all.ipr() == full.ipr() );
+  CHECK( all.ipc() == full.ipc() );
+
+  for( int64_t pr = 0; pr < npr; ++pr ) {
+    const auto& row = grids[1 + pr];
+    CHECK( row.is_valid() == (pr == all.ipr()) );
+    if( row.is_valid() ) {
+      CHECK( row.npr() == 1 );
+      CHECK( row.npc() == npc );
+      CHECK( row.ipc() == all.ipc() );
+    }
+  }
+
+  for( int64_t pc = 0; pc < npc; ++pc ) {
+    const auto& col = grids[1 + npr + pc];
+    CHECK( col.is_valid() == (pc == all.ipc()) );
+    if( col.is_valid() ) CHECK( col.ipr() == all.ipr() );
+  }
+
+  const auto& half = grids.back();
+  CHECK( half.is_valid() == (mpi.rank() < nhalf) );
+
+  // Grids of a batch communicate independently
+  auto& row = grids[1 + all.ipr()];
+  if( npc > 1 ) {
+    int64_t val = all.ipc(), recv = -1;
+    const auto right = (row.ipc() + 1) % npc, left = (row.ipc() + npc - 1) % npc;
+    if( row.ipc() % 2 ) {
+      blacspp::gerv2d( row, 1, 1, &recv, 1, 0, left );
+      blacspp::gesd2d( row, 1, 1, &val,  1, 0, right );
+    } else {
+      blacspp::gesd2d( row, 1, 1, &val,  1, 0, right );
+      blacspp::gerv2d( row, 1, 1, &recv, 1, 0, left );
+    }
+    CHECK( recv == left );
+  }
+
+  // The communicator of a subgrid holds only its members, so operations
+  // collective over it involve the subgrid alone
+  {
+    blacspp::mpi_info row_mpi( row.comm() );
+    CHECK( row_mpi.size() == npc );
+    CHECK( row.comm_rank( 0, row.ipc() ) == row_mpi.rank() );
+
+    auto row_clone = row.clone();
+    REQUIRE( row_clone.is_valid() );
+    CHECK( row_clone.ipc() == row.ipc() );
+
+    auto row_shrunk = row.shrink( { 0 } );
+    CHECK( row_shrunk.is_valid() == (row.ipc() == 0) );
+  }
+
+  if( half.is_valid() ) {
+    blacspp::mpi_info half_mpi( half.internal_comm() );
+    CHECK( half_mpi.size() == nhalf );
+    CHECK( half_mpi.rank() == half.ipr() );
+  }
+
+  // Clones get their own system handle and outlive the batch
+  const auto all_rank = blacspp::mpi_info( all.comm() ).rank();
+  auto clone = all.clone();
+  grids.clear();
+  REQUIRE( clone.is_valid() );
+  CHECK( clone.comm_rank( clone.ipr(), clone.ipc() ) == all_rank );
+
+  CHECK_THROWS( blacspp::Grid::batch( MPI_COMM_WORLD, 
+    { blacspp::GridSpec( 1, 1, std::vector<int64_t>{ mpi.size() } ) } ) );
+  if( mpi.size() > 1 )
+    CHECK_THROWS( blacspp::Grid::batch( MPI_COMM_WORLD, 
+      { blacspp::GridSpec( 1, 1, std::vector<int64_t>{ mpi.rank() } ) } ) );
+
+}
+
+TEST_CASE( "Process Coordinates", "[constructor]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  for( int64_t pr = 0; pr < grid.npr(); ++pr )
+  for( int64_t pc = 0; pc < grid.npc(); ++pc ) {
+    auto coord = blacspp::rank_coordinate( grid, 
+      blacspp::coordinate_rank( grid, pr, pc ) );
+    CHECK( coord.first  == pr );
+    CHECK( coord.second == pc );
+  }
+
+}
@@ -0,0 +1,91 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/coroutine.hpp>
+#include <vector>
+
+
+TEST_CASE( "Coroutine Send-Recv", "[coroutine]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const int64_t ntask = 32;
+  const int64_t nelem = 16;
+
+  const auto npc   = grid.npc();
+  const auto right = (grid.ipc() + 1) % npc;
+  const auto left  = (grid.ipc() + npc - 1) % npc;
+  const auto rank_left = grid.comm_rank( grid.ipr(), left );
+
+  std::vector< std::vector<double> > send( ntask ), recv( ntask );
+  for( int64_t t = 0; t < ntask; ++t ) {
+    send[t].resize( nelem, mpi.rank() * ntask + t );
+    recv[t].resize( nelem, -1. );
+  }
+
+  auto receiver = [&]( int64_t t ) -> blacspp::Task {
+    co_await blacspp::async_gerv2d( grid, recv[t], grid.ipr(), left );
+  };
+  auto sender = [&]( int64_t t ) -> blacspp::Task {
+    co_await blacspp::awaitable( blacspp::igesd2d( grid, send[t], grid.ipr(), right ) );
+  };
+
+  blacspp::Scheduler sched;
+  for( int64_t t = 0; t < ntask; ++t ) sched.spawn( receiver(t) );
+
+  // No process spawns its senders before every process has checked, so 
+  // every receiver is still suspended on its request
+  sched.poll();
+  CHECK( sched.in_flight() == ntask );
+  MPI_Barrier( grid.comm() );
+
+  // Sends from one source match the receives in posting order
+  for( int64_t t = 0; t < ntask; ++t ) sched.spawn( sender(t) );
+  sched.run();
+  CHECK( sched.in_flight() == 0 );
+
+  for( int64_t t = 0; t < ntask; ++t )
+  for( auto x : recv[t] ) CHECK( x == rank_left * ntask + t );
+
+}
+
+TEST_CASE( "Coroutine Broadcast", "[coroutine]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  std::vector<double> data( 8, mpi.rank() );
+  const auto root_rank = grid.comm_rank( grid.ipr(), 0 );
+
+  auto task = [&]() -> blacspp::Task {
+    if( grid.ipc() == 0 )
+      co_await blacspp::async_gebs2d( grid, blacspp::Scope::Row, data );
+    else
+      co_await blacspp::async_gebr2d( grid, blacspp::Scope::Row, data, grid.ipr(), 0 );
+  };
+
+  blacspp::Scheduler sched;
+  sched.spawn( task() );
+  sched.run();
+
+  for( auto x : data ) CHECK( x == root_rank );
+
+}
+
+TEST_CASE( "Coroutine Exception", "[coroutine]" ) {
+
+  auto task = []() -> blacspp::Task {
+    co_await blacspp::awaitable( blacspp::Request() );
+    throw std::runtime_error("task failure");
+  };
+
+  blacspp::Scheduler sched;
+  sched.spawn( task() );
+  CHECK_THROWS_AS( sched.run(), std::runtime_error );
+
+}
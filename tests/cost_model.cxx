@@ -0,0 +1,111 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/cost_model.hpp>
+#include <algorithm>
+#include <cmath>
+
+TEST_CASE( "Cost Model Fits", "[cost_model]" ) {
+
+  blacspp::CostModel model;
+  CHECK_FALSE( model.contains( blacspp::Primitive::Sum, blacspp::Scope::All ) );
+  CHECK_THROWS( model.predict( blacspp::Primitive::Sum, blacspp::Scope::All, 8. ) );
+
+  blacspp::AlphaBeta ring, tree;
+  ring.alpha = 1e-6; ring.beta = 1e-9;
+  tree.alpha = 4e-6; tree.beta = 1e-10;
+  model.set( blacspp::Primitive::Broadcast, blacspp::Scope::Row, 
+             blacspp::Topology::IRing, ring );
+  model.set( blacspp::Primitive::Broadcast, blacspp::Scope::Row, 
+             blacspp::Topology::Tree,  tree );
+
+  CHECK( model.predict( blacspp::Primitive::Broadcast, blacspp::Scope::Row, 
+           1000., blacspp::Topology::IRing ) == Approx( 2e-6 ) );
+  CHECK_FALSE( model.contains( blacspp::Primitive::Broadcast, 
+                 blacspp::Scope::Column, blacspp::Topology::IRing ) );
+
+  // Latency bound messages prefer the ring, bandwidth bound the tree
+  CHECK( model.best_broadcast( blacspp::Scope::Row, 8. ) == 
+         blacspp::Topology::IRing );
+  CHECK( model.best_broadcast( blacspp::Scope::Row, 1e6 ) == 
+         blacspp::Topology::Tree );
+  CHECK_THROWS( model.best_broadcast( blacspp::Scope::All, 8. ) );
+
+  // Topology only distinguishes broadcasts
+  model.set( blacspp::Primitive::PointToPoint, blacspp::Scope::All, 
+             blacspp::Topology::Default, ring );
+  CHECK( model.contains( blacspp::Primitive::PointToPoint, blacspp::Scope::All,
+                         blacspp::Topology::Tree ) );
+
+}
+
+TEST_CASE( "Cost Model Calibration", "[cost_model]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::CostModelOptions opts;
+  opts.repetitions   = 2;
+  opts.message_bytes = { 8, 1 << 12, 1 << 16 };
+  opts.topologies    = { blacspp::Topology::Default, blacspp::Topology::IRing };
+
+  blacspp::CostModel model( grid, opts );
+
+  const blacspp::Scope scopes[] = { blacspp::Scope::All, blacspp::Scope::Row,
+                                    blacspp::Scope::Column };
+  const blacspp::Primitive prims[] = { blacspp::Primitive::PointToPoint, 
+    blacspp::Primitive::Broadcast, blacspp::Primitive::Sum };
+
+  for( auto scope : scopes )
+  for( auto prim  : prims  )
+  for( auto top   : opts.topologies ) {
+
+    REQUIRE( model.contains( prim, scope, top ) );
+    auto ab = model.fit( prim, scope, top );
+    CHECK( std::isfinite( ab.alpha ) );
+    CHECK( std::isfinite( ab.beta  ) );
+    CHECK( ab.alpha >= 0. );
+    CHECK( ab.beta  >= 0. );
+    CHECK( model.predict( prim, scope, 1e6, top ) >= 
+           model.predict( prim, scope, 8.,  top ) );
+
+    // The model is the same on every process
+    double mine[2] = { ab.alpha, ab.beta }, lo[2], hi[2];
+    MPI_Allreduce( mine, lo, 2, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD );
+    MPI_Allreduce( mine, hi, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+    CHECK( lo[0] == hi[0] );
+    CHECK( lo[1] == hi[1] );
+
+  }
+
+  // Single process scopes are free
+  if( grid.npc() == 1 )
+    CHECK( model.predict( blacspp::Primitive::Sum, blacspp::Scope::Row, 1e6 ) == 0. );
+
+  CHECK_THROWS( blacspp::CostModel( blacspp::Grid() ) );
+
+}
+
+TEST_CASE( "Cost Model On Subgrid", "[cost_model]" ) {
+
+  blacspp::mpi_info mpi(MPI_COMM_WORLD);
+
+  // Single row subgrid over the first half of the processes
+  const int64_t n = std::max( mpi.size() / 2, int64_t(1) );
+  auto grids = blacspp::Grid::batch( MPI_COMM_WORLD, { blacspp::GridSpec( 1, n ) } );
+
+  if( grids[0].is_valid() ) {
+    blacspp::CostModelOptions opts;
+    opts.repetitions   = 1;
+    opts.message_bytes = { 8, 1 << 12 };
+    opts.topologies    = { blacspp::Topology::Default };
+
+    blacspp::CostModel model( grids[0], opts );
+    CHECK( model.predict( blacspp::Primitive::Sum, blacspp::Scope::Column, 1e6 ) == 0. );
+    CHECK( model.predict( blacspp::Primitive::Sum, blacspp::Scope::Row, 1e6 ) >= 0. );
+  }
+
+}
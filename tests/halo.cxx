@@ -0,0 +1,66 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/halo.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Halo Exchange", "[halo]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M(4), N(3), W(2), LDA(M + 2*W + 1);
+  const int64_t GM = M * grid.npr(), GN = N * grid.npc();
+
+  // Global field, negative outside the domain
+  auto field = [&]( int64_t gi, int64_t gj, bool periodic ) {
+    if( periodic ) { gi = (gi + GM) % GM; gj = (gj + GN) % GN; }
+    else if( gi < 0 or gi >= GM or gj < 0 or gj >= GN ) return TestType(-1);
+    return TestType( gi + 1000 * gj );
+  };
+
+  auto check = [&]( bool periodic, bool diagonals ) {
+
+    std::vector< TestType > A( LDA * (N + 2*W), TestType(-1) );
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) 
+      A[ (i+W) + (j+W)*LDA ] = field( grid.ipr()*M + i, grid.ipc()*N + j, false );
+
+    blacspp::HaloExchange<TestType> halo( grid, M, N, W, LDA, periodic, diagonals );
+
+    // Split phase: interior could be updated between start and finish
+    halo.start( A.data() );
+    halo.finish();
+
+    for( int64_t j = 0; j < N + 2*W; ++j )
+    for( int64_t i = 0; i < LDA;     ++i ) {
+      const bool in_rows = i >= W and i < M + W;
+      const bool in_cols = j >= W and j < N + W;
+      const bool corner  = not in_rows and not in_cols;
+      const auto gi = grid.ipr()*M + i - W;
+      const auto gj = grid.ipc()*N + j - W;
+      if( i >= M + 2*W or ( corner and not diagonals ) )
+        CHECK( A[i + j*LDA] == TestType(-1) );
+      else
+        CHECK( A[i + j*LDA] == field( gi, gj, periodic ) );
+    }
+
+    // Repeated blocking exchange with the same plan
+    halo.exchange( A.data() );
+    CHECK( A[0 + W*LDA] == field( grid.ipr()*M - W, grid.ipc()*N, periodic ) );
+
+  };
+
+  SECTION( "Non-Periodic" )            { check( false, false ); }
+  SECTION( "Periodic" )                { check( true,  false ); }
+  SECTION( "Non-Periodic Diagonals" )  { check( false, true  ); }
+  SECTION( "Periodic Diagonals" )      { check( true,  true  ); }
+
+}
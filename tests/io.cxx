@@ -0,0 +1,120 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/io.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+// Local part of a block-cyclic matrix with A(i,j) = i + j*M
+template <typename T>
+std::vector<T> io_fill( const blacspp::Grid& grid, const blacspp::BlockCyclic& d ) {
+
+  const auto m = d.local_rows( grid ), n = d.local_cols( grid );
+  std::vector<T> A( m * n );
+  for( int64_t jl = 0; jl < n; ++jl )
+  for( int64_t il = 0; il < m; ++il ) {
+    const auto i = ((il / d.MB) * grid.npr() + 
+                    (grid.ipr() - d.RSRC + grid.npr()) % grid.npr()) * d.MB + il % d.MB;
+    const auto j = ((jl / d.NB) * grid.npc() + 
+                    (grid.ipc() - d.CSRC + grid.npc()) % grid.npc()) * d.NB + jl % d.NB;
+    A[il + jl*m] = T(i + j * d.M);
+  }
+  return A;
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "Matrix File Round Trip", "[io]" ) {
+
+  blacspp::mpi_info world( MPI_COMM_WORLD );
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M = 29, N = 17;
+  const std::string fname = "blacspp_io_test.bin";
+
+  blacspp::BlockCyclic a( M, N, 4, 3, grid.npr() - 1, 0 );
+  auto A = io_fill<TestType>( grid, a );
+  const auto lda = std::max( a.local_rows( grid ), int64_t(1) );
+
+  blacspp::write_matrix( fname, grid, a, A.data(), lda );
+  MPI_Barrier( MPI_COMM_WORLD );
+
+  auto header = blacspp::read_matrix_header( MPI_COMM_WORLD, fname );
+  CHECK( header.M  == M );
+  CHECK( header.N  == N );
+  CHECK( header.MB == 4 );
+  CHECK( header.NB == 3 );
+  CHECK( header.elem_size == int64_t(sizeof(TestType)) );
+
+  // The file is the col-major global matrix after the header
+  if( world.rank() == 0 ) {
+    std::ifstream file( fname, std::ios::binary );
+    file.seekg( 0, std::ios::end );
+    CHECK( int64_t(file.tellg()) == 
+           blacspp::matrix_file_header_bytes + M * N * int64_t(sizeof(TestType)) );
+
+    std::vector<TestType> global( M * N );
+    file.seekg( blacspp::matrix_file_header_bytes );
+    file.read( reinterpret_cast<char*>( global.data() ), 
+               global.size() * sizeof(TestType) );
+    bool col_major = true;
+    for( int64_t k = 0; k < M*N; ++k ) col_major = col_major and global[k] == TestType(k);
+    CHECK( col_major );
+  }
+
+  SECTION( "Same Grid, Padded" ) {
+    const auto ldb = lda + 3;
+    std::vector<TestType> B( ldb * a.local_cols( grid ) );
+    blacspp::read_matrix( fname, grid, a, B.data(), ldb );
+    bool same = true;
+    for( int64_t j = 0; j < a.local_cols( grid ); ++j )
+    for( int64_t i = 0; i < a.local_rows( grid ); ++i )
+      same = same and B[i + j*ldb] == A[i + j*a.local_rows( grid )];
+    CHECK( same );
+  }
+
+  SECTION( "Other Grid Shape" ) {
+    auto flat = grid.reshape( 1, world.size() );
+    blacspp::BlockCyclic b( M, N, 5, 2, 0, world.size() - 1 );
+    std::vector<TestType> B( b.local_rows( flat ) * b.local_cols( flat ) );
+    blacspp::read_matrix( fname, flat, b, B.data(), 
+                          std::max( b.local_rows( flat ), int64_t(1) ) );
+    CHECK( B == io_fill<TestType>( flat, b ) );
+  }
+
+  SECTION( "Batched Subgrid" ) {
+    // Only the members of the subgrid take part in the collective read
+    const int64_t nhalf = std::max( world.size() / 2, int64_t(1) );
+    auto grids = blacspp::Grid::batch( MPI_COMM_WORLD, 
+      { blacspp::GridSpec( nhalf, 1, blacspp::GridOrder::ColMajor ) } );
+    const auto& half = grids[0];
+    if( half.is_valid() ) {
+      blacspp::BlockCyclic b( M, N, 3, 4 );
+      std::vector<TestType> B( b.local_rows( half ) * b.local_cols( half ) );
+      blacspp::read_matrix( fname, half, b, B.data(), 
+                            std::max( b.local_rows( half ), int64_t(1) ) );
+      CHECK( B == io_fill<TestType>( half, b ) );
+    }
+  }
+
+  SECTION( "Mismatch" ) {
+    std::vector<TestType> B( A.size() );
+    blacspp::BlockCyclic wrong( M + 1, N, 4, 3 );
+    CHECK_THROWS( blacspp::read_matrix( fname, grid, wrong, B.data(), lda ) );
+  }
+
+  MPI_Barrier( MPI_COMM_WORLD );
+  if( world.rank() == 0 ) std::remove( fname.c_str() );
+  MPI_Barrier( MPI_COMM_WORLD );
+
+  CHECK_THROWS( blacspp::read_matrix_header( MPI_COMM_WORLD, fname ) );
+
+}
@@ -0,0 +1,74 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/laswp.hpp>
+#include <utility>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Distributed LASWP", "[laswp]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto npr = grid.npr();
+  const auto ipr = grid.ipr();
+
+  const int64_t MB   = 2;
+  const int64_t RSRC = 1 % npr;
+  const int64_t M    = 5*MB*npr + 1;
+  const int64_t N    = 3;
+
+  // Local rows of the block-cyclic distribution
+  std::vector< int64_t > rows;
+  for( int64_t i = 0; i < M; ++i )
+    if( (i / MB + RSRC) % npr == ipr ) rows.emplace_back( i );
+  const int64_t mloc = rows.size();
+  const int64_t LDA  = mloc + 2;
+
+  auto val = [&]( int64_t i, int64_t j ) { return TestType( i + 100*j ); };
+
+  std::vector< TestType > A( LDA*N, TestType(-1) );
+  for( int64_t j = 0; j < N;    ++j )
+  for( int64_t k = 0; k < mloc; ++k ) A[k + j*LDA] = val( rows[k], j );
+
+  // LU-like pivots (IPIV[k] >= k) with some repeated targets
+  const int64_t K1 = 1, K2 = M - 2;
+  std::vector< int64_t > ipiv( K2 - K1 );
+  for( int64_t k = K1; k < K2; ++k ) 
+    ipiv[k-K1] = k + ( (k*7 + 3) % (M - k) );
+
+  // Serial reference
+  std::vector< int64_t > ref( M );
+  for( int64_t i = 0; i < M; ++i ) ref[i] = i;
+  for( int64_t k = K1; k < K2; ++k ) std::swap( ref[k], ref[ipiv[k-K1]] );
+
+  blacspp::RowSwapPlan plan( grid, MB, RSRC, K1, K2, ipiv.data() );
+
+  // First two columns, then the last one with the same plan
+  plan.execute( 2, A.data(), LDA );
+  plan.execute( 1, A.data() + 2*LDA, LDA );
+
+  for( int64_t j = 0; j < N;   ++j )
+  for( int64_t k = 0; k < LDA; ++k ) {
+    if( k < mloc ) CHECK( A[k + j*LDA] == val( ref[rows[k]], j ) );
+    else           CHECK( A[k + j*LDA] == TestType(-1) );
+  }
+
+  // Applying the inverse (reverse order) restores the matrix
+  for( int64_t k = K1; k < K2; ++k ) {
+    const auto kk = K2 - 1 - (k - K1);
+    std::vector< int64_t > one = { ipiv[kk-K1] };
+    blacspp::laswp2d( grid, N, A.data(), LDA, MB, RSRC, kk, kk+1, one.data() );
+  }
+
+  for( int64_t j = 0; j < N;    ++j )
+  for( int64_t k = 0; k < mloc; ++k ) CHECK( A[k + j*LDA] == val( rows[k], j ) );
+
+}
@@ -0,0 +1,205 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/mixed.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+TEST_CASE( "Half Precision Conversions", "[mixed]" ) {
+
+  using blacspp::detail::float_to_float16;
+  using blacspp::detail::float16_to_float;
+  using blacspp::detail::float_to_bfloat16;
+  using blacspp::detail::bfloat16_to_float;
+
+  SECTION( "float16" ) {
+
+    CHECK( float_to_float16( 1.f )     == 0x3c00 );
+    CHECK( float_to_float16( -2.f )    == 0xc000 );
+    CHECK( float_to_float16( 65504.f ) == 0x7bff );
+    CHECK( float_to_float16( 65519.f ) == 0x7bff );
+    CHECK( float_to_float16( 65520.f ) == 0x7c00 );
+    CHECK( float_to_float16( std::ldexp( 1.f,   -24 ) ) == 0x0001 );
+    CHECK( float_to_float16( std::ldexp( 1.f,   -25 ) ) == 0x0000 );
+    CHECK( float_to_float16( std::ldexp( 1.5f,  -25 ) ) == 0x0001 );
+    CHECK( float_to_float16( std::ldexp( 1.f,   -14 ) ) == 0x0400 );
+    CHECK( float_to_float16( 1.f + std::ldexp( 1.f, -11 ) ) == 0x3c00 ); // Tie to even
+    CHECK( float_to_float16( 1.f + std::ldexp( 3.f, -11 ) ) == 0x3c02 ); // Tie to even
+    CHECK( float_to_float16( std::numeric_limits<float>::infinity() ) == 0x7c00 );
+    CHECK( std::isnan( float16_to_float( 
+      float_to_float16( std::numeric_limits<float>::quiet_NaN() ) ) ) );
+
+    // Every finite value round trips exactly
+    for( uint32_t h = 0; h < 0x10000; ++h ) 
+    if( (h & 0x7c00) != 0x7c00 )
+      REQUIRE( float_to_float16( float16_to_float( h ) ) == h );
+
+  }
+
+  SECTION( "bfloat16" ) {
+
+    CHECK( float_to_bfloat16( 1.f )  == 0x3f80 );
+    CHECK( float_to_bfloat16( -2.f ) == 0xc000 );
+    CHECK( float_to_bfloat16( 1.f + std::ldexp( 1.f, -8 ) ) == 0x3f80 ); // Tie to even
+    CHECK( float_to_bfloat16( 1.f + std::ldexp( 3.f, -8 ) ) == 0x3f82 ); // Tie to even
+    CHECK( std::isnan( bfloat16_to_float( 
+      float_to_bfloat16( std::numeric_limits<float>::quiet_NaN() ) ) ) );
+
+    for( uint32_t h = 0; h < 0x10000; ++h ) 
+    if( (h & 0x7f80) != 0x7f80 )
+      REQUIRE( float_to_bfloat16( bfloat16_to_float( h ) ) == h );
+
+  }
+
+  SECTION( "Single Rounding From double" ) {
+
+    // Just above a tie: a double -> float cast lands on the tie, which
+    // would then round to even (down)
+    const double b = 1. + std::ldexp( 1., -8 )  + std::ldexp( 1., -30 );
+    const double h = 1. + std::ldexp( 1., -11 ) + std::ldexp( 1., -40 );
+    CHECK( blacspp::bfloat16( b ).bits == 0x3f81 );
+    CHECK( blacspp::float16( h ).bits  == 0x3c01 );
+    CHECK( blacspp::bfloat16( -b ).bits == 0xbf81 );
+
+    // Exact, overflowing and non-finite values
+    CHECK( blacspp::bfloat16( 1. ).bits == 0x3f80 );
+    CHECK( blacspp::float16( 65519. ).bits == 0x7bff );
+    CHECK( blacspp::float16( 65520. ).bits == 0x7c00 );
+    CHECK( blacspp::bfloat16( 1e300 ).bits == 0x7f80 );
+    CHECK( blacspp::float16( std::ldexp( 1., -200 ) ).bits == 0x0000 );
+    CHECK( std::isnan( float( blacspp::float16( 
+      std::numeric_limits<double>::quiet_NaN() ) ) ) );
+
+  }
+
+}
+
+TEMPLATE_TEST_CASE( "Mixed Precision Transfers", "[mixed]", 
+  float, blacspp::bfloat16, blacspp::float16 ) {
+
+  using wire = TestType;
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+
+  const int64_t M(3), N(4), LDA(5);
+  auto val = []( int64_t p, int64_t i ) { return 1. + p + 1. / (3. + i); };
+  auto rnd = []( double x ) { return double( float( wire( x ) ) ); };
+
+  std::vector< double > A( LDA*N );
+  for( int64_t i = 0; i < LDA*N; ++i ) A[i] = val( me, i );
+
+  // Double -> wire -> double and float
+  std::vector< double > B( LDA*N, -1. );
+  std::vector< float  > F( LDA*N, -1.f );
+  if( me % 2 == 0 ) {
+    blacspp::gesd2d_as<wire>( grid, M, N, A.data(), LDA, next / grid.npc(), next % grid.npc() );
+    blacspp::gesd2d_as<wire>( grid, M, N, A.data(), LDA, next / grid.npc(), next % grid.npc() );
+    blacspp::gerv2d_as<wire>( grid, M, N, B.data(), LDA, prev / grid.npc(), prev % grid.npc() );
+    blacspp::gerv2d_as<wire>( grid, M, N, F.data(), LDA, prev / grid.npc(), prev % grid.npc() );
+  } else {
+    blacspp::gerv2d_as<wire>( grid, M, N, B.data(), LDA, prev / grid.npc(), prev % grid.npc() );
+    blacspp::gerv2d_as<wire>( grid, M, N, F.data(), LDA, prev / grid.npc(), prev % grid.npc() );
+    blacspp::gesd2d_as<wire>( grid, M, N, A.data(), LDA, next / grid.npc(), next % grid.npc() );
+    blacspp::gesd2d_as<wire>( grid, M, N, A.data(), LDA, next / grid.npc(), next % grid.npc() );
+  }
+
+  for( int64_t j = 0; j < N;   ++j )
+  for( int64_t i = 0; i < LDA; ++i ) {
+    if( i < M ) {
+      CHECK( B[i + j*LDA] == rnd( val( prev, i + j*LDA ) ) );
+      CHECK( F[i + j*LDA] == float( rnd( val( prev, i + j*LDA ) ) ) );
+    } else {
+      CHECK( B[i + j*LDA] == -1.  );
+      CHECK( F[i + j*LDA] == -1.f );
+    }
+  }
+
+  // Broadcast along the process row
+  std::vector< double > C( LDA*N, -1. );
+  if( grid.ipc() == 0 )
+    blacspp::gebs2d_as<wire>( grid, blacspp::Scope::Row, M, N, A.data(), LDA );
+  else {
+    blacspp::gebr2d_as<wire>( grid, blacspp::Scope::Row, M, N, C.data(), LDA, 
+                              grid.ipr(), 0 );
+    const auto root = grid.ipr() * grid.npc();
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) 
+      CHECK( C[i + j*LDA] == rnd( val( root, i + j*LDA ) ) );
+  }
+
+  if( grid.npr() > 1 )
+    CHECK_THROWS( blacspp::gebr2d_as<wire>( grid, blacspp::Scope::Row, M, N, 
+      C.data(), LDA, (grid.ipr() + 1) % grid.npr(), 0 ) );
+
+}
+
+TEST_CASE( "Mixed Precision Complex Transfers", "[mixed]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+
+  using blacspp::internal::dcomplex;
+  using blacspp::internal::scomplex;
+
+  std::vector< dcomplex > A( 6 ), B( 6 );
+  for( int64_t i = 0; i < 6; ++i ) A[i] = dcomplex( me + 0.1*i, 1. / (i+3) );
+
+  if( me % 2 == 0 ) {
+    blacspp::gesd2d_as<scomplex>( grid, 6, 1, A.data(), 6, next / grid.npc(), next % grid.npc() );
+    blacspp::gerv2d_as<scomplex>( grid, 6, 1, B.data(), 6, prev / grid.npc(), prev % grid.npc() );
+  } else {
+    blacspp::gerv2d_as<scomplex>( grid, 6, 1, B.data(), 6, prev / grid.npc(), prev % grid.npc() );
+    blacspp::gesd2d_as<scomplex>( grid, 6, 1, A.data(), 6, next / grid.npc(), next % grid.npc() );
+  }
+
+  for( int64_t i = 0; i < 6; ++i ) {
+    const dcomplex ref( prev + 0.1*i, 1. / (i+3) );
+    CHECK( B[i] == dcomplex( scomplex( ref ) ) );
+  }
+
+}
+
+TEST_CASE( "Mixed Precision Beside Plain Traffic", "[mixed]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+  const auto nr = next / grid.npc(), nc = next % grid.npc();
+  const auto pr = prev / grid.npc(), pc = prev % grid.npc();
+
+  // Plain and converted messages of the same byte size, the plain one
+  // posted first: the converted recieve must not pick it up
+  std::vector<double> plain_send( 8, double(me) ), plain_recv( 8, -1. );
+  std::vector<double> A( 32, me + 0.5 ), B( 32, -1. );
+
+  auto sreq = blacspp::igesd2d( grid, plain_send, nr, nc );
+  if( me % 2 == 0 ) {
+    blacspp::gesd2d_as<blacspp::bfloat16>( grid, 32, 1, A.data(), 32, nr, nc );
+    blacspp::gerv2d_as<blacspp::bfloat16>( grid, 32, 1, B.data(), 32, pr, pc );
+  } else {
+    blacspp::gerv2d_as<blacspp::bfloat16>( grid, 32, 1, B.data(), 32, pr, pc );
+    blacspp::gesd2d_as<blacspp::bfloat16>( grid, 32, 1, A.data(), 32, nr, nc );
+  }
+  blacspp::igerv2d( grid, plain_recv, pr, pc ).wait();
+  sreq.wait();
+
+  for( auto x : B ) CHECK( x == double( float( blacspp::bfloat16( prev + 0.5 ) ) ) );
+  for( auto x : plain_recv ) CHECK( x == double(prev) );
+
+}
@@ -0,0 +1,135 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/progress.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Non-Blocking 2D Send-Recv", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const int64_t M(4), N(3), LDA(6);
+
+  std::vector< TestType > data_send( LDA*N, TestType(mpi.rank()) );
+  std::vector< TestType > data_recv( LDA*N, TestType(-1) );
+
+  const auto npc   = grid.npc();
+  const auto right = (grid.ipc() + 1) % npc;
+  const auto left  = (grid.ipc() + npc - 1) % npc;
+  const auto rank_left = grid.comm_rank( grid.ipr(), left );
+
+  auto check = [&]() {
+    for( auto x : data_send ) CHECK( x == TestType(mpi.rank()) );
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i ) {
+      if( i < M ) CHECK( data_recv[i + j*LDA] == TestType(rank_left) );
+      else        CHECK( data_recv[i + j*LDA] == TestType(-1) );
+    }
+  };
+
+  SECTION( "Pointer Interface" ) {
+
+    auto rreq = blacspp::igerv2d( grid, M, N, data_recv.data(), LDA, grid.ipr(), left  );
+    auto sreq = blacspp::igesd2d( grid, M, N, data_send.data(), LDA, grid.ipr(), right );
+
+    sreq.wait();
+    while( not rreq.test() );
+
+    check();
+
+  }
+
+  SECTION( "Progress Engine" ) {
+
+    if( blacspp::mpi_thread_level() < MPI_THREAD_MULTIPLE ) {
+      WARN( "MPI_THREAD_MULTIPLE not provided, skipping" );
+      return;
+    }
+
+    blacspp::ProgressEngine engine;
+    for( int rep = 0; rep < 10; ++rep ) {
+
+      auto rreq = blacspp::igerv2d( grid, M, N, data_recv.data(), LDA, grid.ipr(), left  );
+      auto sreq = blacspp::igesd2d( grid, M, N, data_send.data(), LDA, grid.ipr(), right );
+
+      engine.submit( rreq );
+      engine.submit( sreq );
+
+      rreq.wait();
+      sreq.wait();
+
+      CHECK( rreq.test() );
+      check();
+      std::fill( data_recv.begin(), data_recv.end(), TestType(-1) );
+
+    }
+
+  }
+
+}
+
+TEST_CASE( "Non-Blocking Container Interface", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const auto npc   = grid.npc();
+  const auto right = (grid.ipc() + 1) % npc;
+  const auto left  = (grid.ipc() + npc - 1) % npc;
+
+  std::vector< double > data_send( 10, mpi.rank() ), data_recv( 10, -1. );
+
+  auto rreq = blacspp::igerv2d( grid, data_recv, grid.ipr(), left  );
+  auto sreq = blacspp::igesd2d( grid, data_send, grid.ipr(), right );
+  rreq.wait(); sreq.wait();
+
+  for( auto x : data_recv ) CHECK( x == grid.comm_rank( grid.ipr(), left ) );
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "Non-Blocking 2D Broadcast", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const int64_t M(4), N(4);
+  std::vector< TestType > data( M*N, TestType(mpi.rank()) );
+
+  for( auto scope : { blacspp::Scope::All, blacspp::Scope::Row, blacspp::Scope::Column } ) {
+
+    const int64_t rsrc = scope == blacspp::Scope::Row    ? grid.ipr() : 0;
+    const int64_t csrc = scope == blacspp::Scope::Column ? grid.ipc() : 0;
+    const auto root_rank = grid.comm_rank( rsrc, csrc );
+
+    blacspp::Request req;
+    if( grid.ipr() == rsrc and grid.ipc() == csrc )
+      req = blacspp::igebs2d( grid, scope, M, N, data.data(), M );
+    else
+      req = blacspp::igebr2d( grid, scope, M, N, data.data(), M, rsrc, csrc );
+    req.wait();
+
+    for( auto x : data ) CHECK( x == TestType(root_rank) );
+    std::fill( data.begin(), data.end(), TestType(mpi.rank()) );
+
+  }
+
+  // Roots outside of the scope of this process are rejected
+  if( grid.npr() > 1 )
+    CHECK_THROWS( blacspp::igebr2d( grid, blacspp::Scope::Row, M, N, data.data(), M,
+                                    (grid.ipr() + 1) % grid.npr(), 0 ) );
+  if( grid.npc() > 1 )
+    CHECK_THROWS( blacspp::igebr2d( grid, blacspp::Scope::Column, M, N, data.data(), M,
+                                    0, (grid.ipc() + 1) % grid.npc() ) );
+
+}
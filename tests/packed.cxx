@@ -0,0 +1,111 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/packed.hpp>
+#include <array>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+// Reference trsd2d trapezoid membership
+bool in_trapezoid( blacspp::Uplo uplo, blacspp::Diag diag, int64_t M, int64_t N,
+                   int64_t i, int64_t j ) {
+  const bool unit = diag == blacspp::Diag::Unit;
+  if( uplo == blacspp::Uplo::Upper ) {
+    const int64_t d = std::max<int64_t>( M - N, 0 );
+    return (i - j) < d or ( (i - j) == d and not unit );
+  } else {
+    const int64_t d = std::max<int64_t>( N - M, 0 );
+    return (j - i) < d or ( (j - i) == d and not unit );
+  }
+}
+
+const std::array< std::pair<int64_t,int64_t>, 3 > packed_dims = 
+  {{ { 5, 5 }, { 7, 4 }, { 3, 6 } }};
+
+
+TEST_CASE( "Trapezoid Packing", "[packed]" ) {
+
+  using blacspp::Uplo;
+  using blacspp::Diag;
+
+  CHECK( blacspp::detail::trapezoid_size( Uplo::Upper, Diag::NonUnit, 6, 6 ) == 21 );
+  CHECK( blacspp::detail::trapezoid_size( Uplo::Lower, Diag::Unit,    6, 6 ) == 15 );
+
+  for( auto uplo : { Uplo::Upper, Uplo::Lower } )
+  for( auto diag : { Diag::Unit, Diag::NonUnit } )
+  for( auto dim  : packed_dims ) {
+    const auto M = dim.first, N = dim.second;
+    int64_t ref = 0;
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) ref += in_trapezoid( uplo, diag, M, N, i, j );
+    CHECK( blacspp::detail::trapezoid_size( uplo, diag, M, N ) == ref );
+  }
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "Packed Triangular Transfers", "[packed]" ) {
+
+  using blacspp::Uplo;
+  using blacspp::Diag;
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+
+  for( auto uplo : { Uplo::Upper, Uplo::Lower } )
+  for( auto diag : { Diag::Unit, Diag::NonUnit } )
+  for( auto dim  : packed_dims ) {
+
+    const auto M = dim.first, N = dim.second, LDA = M + 1;
+    std::vector< TestType > A( LDA*N ), B( LDA*N, TestType(-1) );
+    for( int64_t i = 0; i < LDA*N; ++i ) A[i] = TestType( me + 10*i );
+
+    // Point-to-point ring
+    if( me % 2 == 0 ) {
+      blacspp::trsd2d_packed( grid, uplo, diag, M, N, A.data(), LDA, 
+                              next / grid.npc(), next % grid.npc() );
+      blacspp::trrv2d_packed( grid, uplo, diag, M, N, B.data(), LDA, 
+                              prev / grid.npc(), prev % grid.npc() );
+    } else {
+      blacspp::trrv2d_packed( grid, uplo, diag, M, N, B.data(), LDA, 
+                              prev / grid.npc(), prev % grid.npc() );
+      blacspp::trsd2d_packed( grid, uplo, diag, M, N, A.data(), LDA, 
+                              next / grid.npc(), next % grid.npc() );
+    }
+
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i ) {
+      if( i < M and in_trapezoid( uplo, diag, M, N, i, j ) )
+        CHECK( B[i + j*LDA] == TestType( prev + 10*(i + j*LDA) ) );
+      else
+        CHECK( B[i + j*LDA] == TestType(-1) );
+    }
+
+    // Broadcast over the grid from (0,0)
+    std::vector< TestType > C( LDA*N, TestType(-1) );
+    if( me == 0 )
+      blacspp::trbs2d_packed( grid, blacspp::Scope::All, uplo, diag, M, N, 
+                              A.data(), LDA );
+    else {
+      blacspp::trbr2d_packed( grid, blacspp::Scope::All, uplo, diag, M, N, 
+                              C.data(), LDA, 0, 0 );
+      for( int64_t j = 0; j < N;   ++j )
+      for( int64_t i = 0; i < LDA; ++i ) {
+        if( i < M and in_trapezoid( uplo, diag, M, N, i, j ) )
+          CHECK( C[i + j*LDA] == TestType( 10*(i + j*LDA) ) );
+        else
+          CHECK( C[i + j*LDA] == TestType(-1) );
+      }
+    }
+
+  }
+
+}
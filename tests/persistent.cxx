@@ -0,0 +1,122 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/persistent.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <array>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+const std::array< blacspp::Scope, 3 > persistent_scopes = 
+  { blacspp::Scope::All, blacspp::Scope::Row, blacspp::Scope::Column };
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Persistent Point-to-Point", "[persistent]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  // Ring over the row-major ordering of the grid
+  const auto P = grid.npr() * grid.npc();
+  const auto me = grid.ipr() * grid.npc() + grid.ipc();
+  const auto next = (me + 1) % P, prev = (me - 1 + P) % P;
+
+  const int64_t M(3), N(2), LDA(4);
+  std::vector< TestType > A( LDA*N ), B( LDA*N, TestType(-1) );
+
+  auto send = blacspp::gesd2d_init( grid, M, N, A.data(), LDA, 
+                                    next / grid.npc(), next % grid.npc() );
+  auto recv = blacspp::gerv2d_init( grid, M, N, B.data(), LDA, 
+                                    prev / grid.npc(), prev % grid.npc() );
+
+  for( int step = 0; step < 3; ++step ) {
+
+    for( int64_t i = 0; i < LDA*N; ++i ) A[i] = TestType( me + 10*step + 100*i );
+
+    recv.start(); send.start();
+    CHECK( recv.active() );
+    send.wait();
+    while( not recv.test() );
+    CHECK( not recv.active() );
+
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i )
+      if( i < M ) CHECK( B[i + j*LDA] == TestType( prev + 10*step + 100*(i + j*LDA) ) );
+      else        CHECK( B[i + j*LDA] == TestType(-1) );
+
+  }
+
+  // Interoperates with the non-blocking interface
+  std::vector< TestType > a( 5, TestType(me) ), b( 5 );
+  auto psend = blacspp::gesd2d_init( grid, a, next / grid.npc(), next % grid.npc() );
+  auto r = blacspp::igerv2d( grid, b, prev / grid.npc(), prev % grid.npc() );
+  psend.start(); psend.wait(); r.wait();
+  for( auto x : b ) CHECK( x == TestType(prev) );
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "Persistent Collectives", "[persistent]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  for( auto scope : persistent_scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto P  = members.size();
+    const auto me = members.me;
+
+    // Broadcast from the last participant of the scope
+    const auto rsrc = scope == blacspp::Scope::Row    ? grid.ipr() : grid.npr()-1;
+    const auto csrc = scope == blacspp::Scope::Column ? grid.ipc() : grid.npc()-1;
+    const bool root = me == P-1;
+
+    const int64_t M(3), N(2), LDA(5);
+    std::vector< TestType > A( LDA*N, TestType(-1) );
+    auto bcast = root ? 
+      blacspp::gebs2d_init( grid, scope, M, N, A.data(), LDA ) :
+      blacspp::gebr2d_init( grid, scope, M, N, A.data(), LDA, rsrc, csrc );
+
+    // Sum of a padded and a contiguous buffer
+    std::vector< TestType > S( LDA*N ), s( 7 );
+    auto sum  = blacspp::gsum2d_init( grid, scope, M, N, S.data(), LDA );
+    auto csum = blacspp::gsum2d_init( grid, scope, s );
+
+    for( int step = 0; step < 3; ++step ) {
+
+      if( root ) 
+        for( int64_t i = 0; i < LDA*N; ++i ) A[i] = TestType( step + i );
+      for( auto& x : S ) x = TestType( me + step );
+      for( auto& x : s ) x = TestType( 1 );
+
+      bcast.start(); sum.start(); csum.start();
+      bcast.wait();  sum.wait();  csum.wait();
+
+      for( int64_t j = 0; j < N;   ++j )
+      for( int64_t i = 0; i < LDA; ++i ) {
+        if( i < M ) {
+          CHECK( A[i + j*LDA] == TestType( step + i + j*LDA ) );
+          CHECK( S[i + j*LDA] == TestType( P*(P-1)/2 + P*step ) );
+        } else {
+          CHECK( S[i + j*LDA] == TestType( me + step ) );
+        }
+      }
+      for( auto x : s ) CHECK( x == TestType(P) );
+
+    }
+
+  }
+
+  // The root is checked before anything is initialized, on either path
+  if( grid.npr() > 1 ) {
+    std::vector< TestType > A( 4 );
+    CHECK_THROWS( blacspp::gebr2d_init( grid, blacspp::Scope::Row, 4, 1, A.data(), 4,
+                                        (grid.ipr() + 1) % grid.npr(), 0 ) );
+  }
+
+}
@@ -0,0 +1,85 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/pivot.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Pivot Search", "[pivot]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const auto npr = grid.npr();
+  const auto ipr = grid.ipr();
+  const auto jcol = 7 + grid.ipc();
+
+  // Global column of length 3*npr distributed row-cyclically over the
+  // process column
+  const int64_t mloc = 3;
+  std::vector< int64_t > rows( mloc );
+  for( int64_t k = 0; k < mloc; ++k ) rows[k] = ipr + k*npr;
+  const auto mglb = mloc * npr;
+
+  SECTION( "Unique Maximum" ) {
+
+    // The entry of largest magnitude is negative and in the middle
+    const auto imax = mglb / 2;
+    std::vector< TestType > v( mloc );
+    for( int64_t k = 0; k < mloc; ++k ) 
+      v[k] = rows[k] == imax ? TestType(-100) : TestType( rows[k] % 5 );
+
+    auto p = blacspp::pivot_search( grid, blacspp::Scope::Column, v.data(), 
+                                    mloc, rows.data(), jcol );
+    CHECK( p.value == TestType(-100) );
+    CHECK( p.row   == imax );
+    CHECK( p.col   == jcol );
+
+  }
+
+  SECTION( "Ties" ) {
+
+    // Every entry has the same magnitude: the smallest row wins
+    std::vector< TestType > v( mloc );
+    for( int64_t k = 0; k < mloc; ++k ) 
+      v[k] = rows[k] % 2 ? TestType(-3) : TestType(3);
+
+    auto p = blacspp::pivot_search( grid, blacspp::Scope::Column, v.data(), 
+                                    mloc, rows.data(), jcol );
+    CHECK( p.value == TestType(3) );
+    CHECK( p.row   == 0 );
+    CHECK( p.col   == jcol );
+
+    // Across process columns the smallest column wins
+    auto q = blacspp::pivot_search( grid, blacspp::Scope::All, v.data(), 
+                                    mloc, rows.data(), jcol );
+    CHECK( q.row == 0 );
+    CHECK( q.col == 7 );
+
+  }
+
+  SECTION( "Empty" ) {
+
+    // Only the last process row holds values
+    const int64_t n = ipr == npr-1 ? mloc : 0;
+    std::vector< TestType > v( mloc, TestType(1) );
+
+    auto p = blacspp::pivot_search( grid, blacspp::Scope::Column, v.data(), 
+                                    n, rows.data(), jcol );
+    CHECK( p.value == TestType(1) );
+    CHECK( p.row   == npr-1 );
+
+    auto e = blacspp::pivot_search( grid, blacspp::Scope::Column, v.data(), 
+                                    0, rows.data(), jcol );
+    CHECK( e.row == -1 );
+    CHECK( e.col == -1 );
+
+  }
+
+}
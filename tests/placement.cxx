@@ -0,0 +1,132 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/placement.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Synthetic profile where (i,j) is fast iff i + j == nprocs - 1
+blacspp::LinkProfile paired_profile( int64_t np ) {
+  blacspp::LinkProfile profile;
+  profile.nprocs = np;
+  profile.latency.assign( np*np, 1e-5 );
+  profile.inv_bandwidth.assign( np*np, 1e-9 );
+  for( int64_t i = 0; i < np; ++i ) {
+    profile.latency[ i + (np-1-i)*np ]       = 1e-7;
+    profile.inv_bandwidth[ i + (np-1-i)*np ] = 1e-11;
+  }
+  return profile;
+}
+
+TEST_CASE( "Placement Heuristic", "[placement]" ) {
+
+  const int64_t npr = 3, npc = 2;
+  auto profile = paired_profile( npr * npc );
+
+  // Only row traffic: the fast pairs should share process rows
+  blacspp::PlacementWeights weights;
+  weights.col_share = 0.;
+
+  auto map = blacspp::optimize_placement( profile, npr, npc, weights );
+
+  std::vector<int64_t> sorted( map );
+  std::sort( sorted.begin(), sorted.end() );
+  for( int64_t i = 0; i < npr*npc; ++i ) CHECK( sorted[i] == i );
+
+  for( int64_t pr = 0; pr < npr; ++pr )
+    CHECK( map[pr] + map[pr + npr] == npr*npc - 1 );
+
+  std::vector<int64_t> row_major( npr*npc );
+  for( int64_t pc = 0; pc < npc; ++pc )
+  for( int64_t pr = 0; pr < npr; ++pr )
+    row_major[ pr + pc*npr ] = pr*npc + pc;
+
+  CHECK( blacspp::placement_cost( profile, npr, npc, map, weights ) <
+         blacspp::placement_cost( profile, npr, npc, row_major, weights ) );
+
+  CHECK_THROWS( blacspp::optimize_placement( profile, 2, 2 ) );
+
+}
+
+TEST_CASE( "Link Profile Cache", "[placement]" ) {
+
+  blacspp::mpi_info world( MPI_COMM_WORLD );
+
+  blacspp::CalibrationOptions opts;
+  opts.repetitions   = 2;
+  opts.message_bytes = 1 << 12;
+
+  const std::string fname = "blacspp_link_profile.txt";
+  if( world.rank() == 0 ) std::remove( fname.c_str() );
+  MPI_Barrier( MPI_COMM_WORLD );
+
+  auto profile = blacspp::calibrate_links( MPI_COMM_WORLD, opts, fname );
+
+  REQUIRE( profile.nprocs == world.size() );
+  for( int64_t i = 0; i < world.size(); ++i )
+  for( int64_t j = 0; j < world.size(); ++j ) {
+    const double c = profile.cost( i, j, 1024. );
+    CHECK( std::isfinite( c ) );
+    CHECK( c >= 0. );
+    CHECK( c == profile.cost( j, i, 1024. ) );
+  }
+
+  // Second call reuses the cached measurement
+  auto cached = blacspp::calibrate_links( MPI_COMM_WORLD, opts, fname );
+  CHECK( cached.latency       == profile.latency );
+  CHECK( cached.inv_bandwidth == profile.inv_bandwidth );
+
+  MPI_Barrier( MPI_COMM_WORLD );
+  if( world.rank() == 0 ) std::remove( fname.c_str() );
+  MPI_Barrier( MPI_COMM_WORLD );
+
+  CHECK_THROWS( blacspp::LinkProfile::load( fname ) );
+
+}
+
+TEST_CASE( "Sampled Calibration", "[placement]" ) {
+
+  blacspp::mpi_info world( MPI_COMM_WORLD );
+
+  blacspp::CalibrationOptions opts;
+  opts.repetitions   = 2;
+  opts.message_bytes = 1 << 12;
+  opts.max_rounds    = 1;
+
+  auto profile = blacspp::calibrate_links( MPI_COMM_WORLD, opts );
+  for( int64_t i = 0; i < world.size(); ++i )
+  for( int64_t j = 0; j < world.size(); ++j )
+  if( i != j ) CHECK( profile.latency[ i + j*world.size() ] > 0. );
+
+}
+
+TEST_CASE( "Placed Grid", "[placement]" ) {
+
+  blacspp::mpi_info world( MPI_COMM_WORLD );
+
+  int64_t npr = std::sqrt( world.size() );
+  while( world.size() % npr ) npr--;
+  const int64_t npc = world.size() / npr;
+
+  blacspp::CalibrationOptions opts;
+  opts.repetitions   = 2;
+  opts.message_bytes = 1 << 12;
+
+  auto profile = blacspp::calibrate_links( MPI_COMM_WORLD, opts );
+  auto grid    = blacspp::placed_grid( MPI_COMM_WORLD, npr, npc, profile );
+
+  REQUIRE( grid.is_valid() );
+  CHECK( grid.npr() == npr );
+  CHECK( grid.npc() == npc );
+
+  // Every process holds the same map, so coordinates are consistent
+  auto map = blacspp::optimize_placement( profile, npr, npc );
+  CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == world.rank() );
+  CHECK( map[ grid.ipr() + grid.ipc()*npr ] == world.rank() );
+
+}
@@ -0,0 +1,121 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/redistribute.hpp>
+#include <vector>
+
+// Fill the local part of a block-cyclic matrix with A(i,j) = i + j*M
+std::vector<double> redistribute_fill( const blacspp::Grid& grid, 
+                                       const blacspp::BlockCyclic& d ) {
+
+  const auto m = d.local_rows( grid ), n = d.local_cols( grid );
+  std::vector<double> A( m * n );
+  for( int64_t jl = 0; jl < n; ++jl )
+  for( int64_t il = 0; il < m; ++il ) {
+    const auto i = ((il / d.MB) * grid.npr() + 
+                    (grid.ipr() - d.RSRC + grid.npr()) % grid.npr()) * d.MB + il % d.MB;
+    const auto j = ((jl / d.NB) * grid.npc() + 
+                    (grid.ipc() - d.CSRC + grid.npc()) % grid.npc()) * d.NB + jl % d.NB;
+    A[il + jl*m] = i + j * d.M;
+  }
+  return A;
+
+}
+
+TEST_CASE( "Block Cyclic Local Extents", "[redistribute]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::BlockCyclic d( 37, 23, 4, 3, grid.npr() - 1, 0 );
+
+  int64_t m = d.local_rows( grid ), n = d.local_cols( grid ), total;
+  int64_t mine = m * n;
+  MPI_Allreduce( &mine, &total, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD );
+  CHECK( total == d.M * d.N );
+
+  CHECK( blacspp::BlockCyclic::numroc( 10, 3, 0, 0, 2 ) == 6 );
+  CHECK( blacspp::BlockCyclic::numroc( 10, 3, 1, 0, 2 ) == 4 );
+  CHECK( blacspp::BlockCyclic::numroc( 10, 3, 0, 1, 2 ) == 4 );
+
+}
+
+TEST_CASE( "Redistribute Between Grids", "[redistribute]" ) {
+
+  blacspp::mpi_info world( MPI_COMM_WORLD );
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M = 37, N = 23;
+  blacspp::BlockCyclic a( M, N, 4, 3, 0, grid.npc() - 1 );
+  auto A = redistribute_fill( grid, a );
+  const auto lda = std::max( a.local_rows( grid ), int64_t(1) );
+
+  auto check = [&]( const blacspp::Grid& g, const blacspp::BlockCyclic& d, 
+                    const std::vector<double>& B ) {
+    if( not g.is_valid() ) return;
+    auto ref = redistribute_fill( g, d );
+    REQUIRE( B.size() == ref.size() );
+    CHECK( B == ref );
+  };
+
+  auto move = [&]( const blacspp::Grid& g, const blacspp::BlockCyclic& d ) {
+    std::vector<double> B( g.is_valid() ? d.local_rows( g ) * d.local_cols( g ) : 0 );
+    const auto ldb = g.is_valid() ? std::max( d.local_rows( g ), int64_t(1) ) : 1;
+    blacspp::redistribute2d( MPI_COMM_WORLD, grid, a, A.data(), lda, 
+                             g, d, B.data(), ldb );
+    return B;
+  };
+
+  SECTION( "Same Layout" ) {
+    blacspp::RedistributePlan plan( MPI_COMM_WORLD, grid, a, grid, a );
+    CHECK( plan.send_count()    == 0 );
+    CHECK( plan.partner_count() == 0 );
+    check( grid, a, move( grid, a ) );
+  }
+
+  SECTION( "Reblock" ) {
+    blacspp::BlockCyclic b( M, N, 5, 2, grid.npr() - 1, 0 );
+    check( grid, b, move( grid, b ) );
+  }
+
+  SECTION( "Reshape" ) {
+    auto flat = grid.reshape( 1, world.size() );
+    REQUIRE( flat.is_valid() );
+    CHECK( flat.npr() == 1 );
+    CHECK( flat.npc() == world.size() );
+    blacspp::BlockCyclic b( M, N, 8, 2 );
+    check( flat, b, move( flat, b ) );
+  }
+
+  SECTION( "Shrink And Grow" ) {
+
+    std::vector<int64_t> active;
+    for( int64_t r = world.size() - 1; r >= 0; r -= 2 ) active.push_back( r );
+
+    auto small = grid.shrink( active );
+    const bool is_active = world.rank() % 2 == (world.size() - 1) % 2;
+    CHECK( small.is_valid() == is_active );
+    if( not small.is_valid() ) CHECK( small.comm() == MPI_COMM_NULL );
+    else CHECK( small.npr() * small.npc() == int64_t(active.size()) );
+
+    blacspp::BlockCyclic b( M, N, 3, 3 );
+    auto B = move( small, b );
+    check( small, b, B );
+
+    // And back onto the full grid
+    std::vector<double> C( A.size(), -1. );
+    blacspp::redistribute2d( MPI_COMM_WORLD, small, b, B.data(), 
+      small.is_valid() ? std::max( b.local_rows( small ), int64_t(1) ) : 1,
+      grid, a, C.data(), lda );
+    CHECK( C == A );
+
+  }
+
+  CHECK_THROWS( blacspp::RedistributePlan( MPI_COMM_WORLD, grid, a, grid, 
+                  blacspp::BlockCyclic( M+1, N, 4, 3 ) ) );
+  CHECK_THROWS( grid.reshape( world.size() + 1, 1 ) );
+  CHECK_THROWS( grid.shrink( { world.size() } ) );
+
+}
@@ -0,0 +1,183 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/reduce.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+const std::array< blacspp::Scope, 3 > reduce_scopes = 
+  { blacspp::Scope::All, blacspp::Scope::Row, blacspp::Scope::Column };
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "User Reduce Sum", "[reduce]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M(3), N(2), LDA(5);
+  auto sum = []( const TestType& a, const TestType& b ) { return a + b; };
+
+  for( auto scope : reduce_scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto P = members.size();
+
+    std::vector< TestType > A( LDA*N, TestType(-1) );
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) A[i + j*LDA] = TestType(members.me + i + j);
+
+    blacspp::reduce2d( grid, scope, sum, M, N, A.data(), LDA );
+
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i ) {
+      if( i < M ) CHECK( A[i + j*LDA] == TestType( P*(P-1)/2 + P*(i+j) ) );
+      else        CHECK( A[i + j*LDA] == TestType(-1) );
+    }
+
+    // Rooted reduction to the last participant of the scope
+    std::vector< TestType > B( 4, TestType(1) );
+    const auto rdest = scope == blacspp::Scope::Row    ? grid.ipr() : grid.npr()-1;
+    const auto cdest = scope == blacspp::Scope::Column ? grid.ipc() : grid.npc()-1;
+    blacspp::reduce2d( grid, scope, sum, 4, 1, B.data(), 4, rdest, cdest );
+    if( members.me == P-1 )
+      for( auto x : B ) CHECK( x == TestType(P) );
+
+  }
+
+}
+
+TEST_CASE( "User Reduce Operators", "[reduce]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const auto P  = mpi.size();
+  const auto me = blacspp::detail::scope_members( grid, blacspp::Scope::All ).me;
+
+  SECTION( "Logical-Or Mask" ) {
+
+    // Participant p sets bit p
+    std::vector< uint8_t > mask( P, 0 );
+    mask[me] = 1;
+    blacspp::reduce2d( grid, blacspp::Scope::All, 
+      []( const uint8_t& a, const uint8_t& b ) -> uint8_t { return a | b; }, mask );
+    for( auto x : mask ) CHECK( x == 1 );
+
+  }
+
+  SECTION( "MaxLoc" ) {
+
+    struct value_index { double val; int64_t idx; };
+    auto maxloc = []( const value_index& a, const value_index& b ) {
+      return b.val > a.val ? b : a;
+    };
+
+    // Ties resolve to the lowest participant
+    std::vector< value_index > v = { { double(me % 2), me }, { -double(me), me } };
+    blacspp::reduce2d( grid, blacspp::Scope::All, maxloc, v );
+    CHECK( v[0].val == double(P > 1) );
+    CHECK( v[0].idx == int64_t(P > 1) );
+    CHECK( v[1].val == 0. );
+    CHECK( v[1].idx == 0 );
+
+  }
+
+  SECTION( "Ordered Non-Commutative" ) {
+
+    // Composition of affine maps x -> a*x + b, which only associates:
+    // participant p contributes (10,p) so the result spells 0 1 2 ... P-1
+    std::vector< double > S = { 10., double(me) };
+    blacspp::reduce2d( grid, blacspp::Scope::All,
+      []( const double* in, double* inout, int64_t ) {
+        inout[1] = inout[1] * in[0] + in[1];
+        inout[0] = inout[0] * in[0];
+      }, S );
+    double ref = 0.;
+    for( int64_t p = 0; p < P; ++p ) ref = ref*10. + p;
+    CHECK( S[1] == ref );
+
+  }
+
+}
+
+TEST_CASE( "Fused Reduction", "[reduce]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  for( auto scope : reduce_scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto P  = members.size();
+    const auto me = members.me;
+
+    double                            d[3] = { 1., 2., double(me) };
+    std::vector<float>                f( 5, float(me) );
+    std::vector<int64_t>              i( 2, me );
+    std::vector<blacspp::internal::dcomplex> z( 1, blacspp::internal::dcomplex(1., me) );
+    char                              c = char(me);
+    blacspp::internal::blacs_int      n = 1;
+
+    blacspp::FusedReduction fused;
+    fused.sum( d, 3 ).max( f ).min( i ).sum( z ).max( &c, 1 ).sum( &n, 1 );
+    CHECK( fused.size() == 6 );
+
+    // Repeated execution reuses the registered buffers
+    for( int rep = 0; rep < 2; ++rep ) {
+
+      d[0] = 1.; d[1] = 2.; d[2] = double(me);
+      std::fill( f.begin(), f.end(), float(me) );
+      std::fill( i.begin(), i.end(), me );
+      z[0] = blacspp::internal::dcomplex(1., me);
+      c = char(me); n = 1;
+
+      fused.execute( grid, scope );
+
+      CHECK( d[0] == double(P) );
+      CHECK( d[1] == double(2*P) );
+      CHECK( d[2] == double(P*(P-1)/2) );
+      for( auto x : f ) CHECK( x == float(P-1) );
+      for( auto x : i ) CHECK( x == 0 );
+      CHECK( z[0] == blacspp::internal::dcomplex( P, P*(P-1)/2 ) );
+      CHECK( c == char(P-1) );
+      CHECK( n == P );
+
+    }
+
+  }
+
+}
+
+TEST_CASE( "Reduce Destination Outside Scope", "[reduce]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  std::vector<double> A( 4, 1. );
+  auto plus = []( double a, double b ) { return a + b; };
+
+  // Destinations must share the scope of the caller
+  if( grid.npr() > 1 )
+    CHECK_THROWS( blacspp::reduce2d( grid, blacspp::Scope::Row, plus, 4, 1, 
+      A.data(), 4, (grid.ipr() + 1) % grid.npr(), 0 ) );
+  if( grid.npc() > 1 )
+    CHECK_THROWS( blacspp::reduce2d( grid, blacspp::Scope::Column, plus, 4, 1, 
+      A.data(), 4, 0, (grid.ipc() + 1) % grid.npc() ) );
+
+  double x = 1.;
+  blacspp::FusedReduction fused;
+  fused.sum( &x, 1 );
+  if( grid.npr() > 1 )
+    CHECK_THROWS( fused.execute( grid, blacspp::Scope::Row, 
+      (grid.ipr() + 1) % grid.npr(), 0 ) );
+
+  // Destinations in the scope are reduced to
+  blacspp::reduce2d( grid, blacspp::Scope::Row, plus, 4, 1, A.data(), 4, 
+                     grid.ipr(), 0 );
+  if( grid.ipc() == 0 ) for( auto a : A ) CHECK( a == double(grid.npc()) );
+
+}
@@ -0,0 +1,108 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/scan.hpp>
+#include <array>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+const std::array< blacspp::Scope, 3 > scan_scopes = 
+  { blacspp::Scope::All, blacspp::Scope::Row, blacspp::Scope::Column };
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Scan", "[scan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M(3), N(2), LDA(4);
+
+  for( auto scope : scan_scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto p = members.me;
+
+    // Participant p contributes (p+1) + i + j
+    std::vector< TestType > A( LDA*N, TestType(-1) ), B;
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) A[i + j*LDA] = TestType(p + 1 + i + j);
+    B = A;
+
+    blacspp::scan2d  ( grid, scope, M, N, A.data(), LDA );
+    blacspp::exscan2d( grid, scope, M, N, B.data(), LDA );
+
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i ) {
+      if( i < M ) {
+        CHECK( A[i + j*LDA] == TestType( (p+1)*(p+2)/2 + (p+1)*(i+j) ) );
+        CHECK( B[i + j*LDA] == TestType(  p   *(p+1)/2 +  p   *(i+j) ) );
+      } else {
+        CHECK( A[i + j*LDA] == TestType(-1) );
+        CHECK( B[i + j*LDA] == TestType(-1) );
+      }
+    }
+
+    // Container interface
+    std::vector< TestType > a( 5, TestType(1) ), b( 5, TestType(1) );
+    blacspp::scan2d  ( grid, scope, a );
+    blacspp::exscan2d( grid, scope, b );
+    for( auto x : a ) CHECK( x == TestType(p+1) );
+    for( auto x : b ) CHECK( x == TestType(p)   );
+
+  }
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Non-Blocking Scan", "[scan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  for( auto scope : scan_scopes ) {
+
+    blacspp::detail::scope_members members( grid, scope );
+    const auto p = members.me;
+
+    std::vector< TestType > a( 7, TestType(2) ), b( 7, TestType(2) );
+
+    // Driven to completion through test()
+    auto req = blacspp::iexscan2d( grid, scope, b );
+    while( not req.test() );
+    for( auto x : b ) CHECK( x == TestType(2*p) );
+
+    blacspp::iscan2d( grid, scope, a ).wait();
+    for( auto x : a ) CHECK( x == TestType(2*(p+1)) );
+
+  }
+
+}
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Concurrent Scans Over Different Scopes", "[scan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  // One scan per scope in flight at once, each with distinct contributions.
+  // Odd processes post them in reverse order, so that messages of different
+  // scans between the same pair of processes are posted out of order
+  const size_t nscope = scan_scopes.size();
+  const bool   odd    = (grid.ipr() * grid.npc() + grid.ipc()) % 2;
+  std::vector< std::vector< TestType > > data;
+  std::vector< blacspp::Request > reqs( nscope );
+  for( size_t s = 0; s < nscope; ++s ) data.emplace_back( 4, TestType(s+1) );
+  for( size_t i = 0; i < nscope; ++i ) {
+    const size_t s = odd ? nscope - 1 - i : i;
+    reqs[s] = blacspp::iscan2d( grid, scan_scopes[s], data[s] );
+  }
+
+  for( auto& r : reqs ) r.wait();
+
+  for( size_t s = 0; s < nscope; ++s ) {
+    blacspp::detail::scope_members members( grid, scan_scopes[s] );
+    for( auto x : data[s] ) CHECK( x == TestType( (s+1)*(members.me+1) ) );
+  }
+
+}
@@ -7,6 +7,7 @@
 #include <catch2/catch.hpp>
 #include <blacspp/send_recv.hpp>
 #include <blacspp/information.hpp>
+#include <cstdint>
 #include <vector>
 
 #define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
@@ -162,3 +163,65 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Send-Recv", "[send-recv]" ) {
   }
 
 }
+
+
+// Non-BLACS types: packed (odd size) and scaled (word multiple) transport
+struct rgb_pixel { uint8_t r, g, b; };
+struct indexed_value { double value; int32_t index; };
+
+template <typename T> T transport_value( int64_t x );
+template <> int64_t   transport_value( int64_t x ) { return (x << 35) + x; }
+template <> uint8_t   transport_value( int64_t x ) { return uint8_t( x * 7 ); }
+template <> rgb_pixel transport_value( int64_t x ) { 
+  return rgb_pixel{ uint8_t(x), uint8_t(x+1), uint8_t(x+2) }; 
+}
+template <> indexed_value transport_value( int64_t x ) { 
+  return indexed_value{ 0.5 * x, int32_t(-x) }; 
+}
+
+bool operator==( const rgb_pixel& a, const rgb_pixel& b ) {
+  return a.r == b.r and a.g == b.g and a.b == b.b;
+}
+bool operator==( const indexed_value& a, const indexed_value& b ) {
+  return a.value == b.value and a.index == b.index;
+}
+
+TEMPLATE_TEST_CASE( "Non-BLACS Type 2D Send-Recv", "[send-recv]", 
+  int64_t, uint8_t, rgb_pixel, indexed_value ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const int64_t M(3), N(4), LDA(5);
+  const auto fill = transport_value<TestType>( -1 );
+
+  std::vector< TestType > data_send( LDA*N ), data_recv( LDA*N, fill );
+  for( int64_t i = 0; i < LDA*N; ++i ) 
+    data_send[i] = transport_value<TestType>( 100*grid.ipr() + i );
+
+  if( grid.ipc() == 0 ) {
+    for( int i = 1; i < grid.npc(); ++i )
+      blacspp::gesd2d( grid, M, N, data_send.data(), LDA, grid.ipr(), i );
+  } else {
+    blacspp::gerv2d( grid, M, N, data_recv.data(), LDA, grid.ipr(), 0 );
+
+    for( int64_t j = 0; j < N;   ++j )
+    for( int64_t i = 0; i < LDA; ++i ) {
+      if( i < M ) 
+        CHECK( data_recv[i + j*LDA] == data_send[i + j*LDA] );
+      else        
+        CHECK( data_recv[i + j*LDA] == fill );
+    }
+  }
+
+  // Abbreviated container interface
+  std::vector< TestType > vec_recv( LDA*N, fill );
+  if( grid.ipc() == 0 ) {
+    for( int i = 1; i < grid.npc(); ++i )
+      blacspp::gesd2d( grid, data_send, grid.ipr(), i );
+  } else {
+    blacspp::gerv2d( grid, vec_recv, grid.ipr(), 0 );
+    for( int64_t i = 0; i < LDA*N; ++i ) 
+      CHECK( vec_recv[i] == data_send[i] );
+  }
+
+}
@@ -0,0 +1,103 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/shift.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::internal::blacs_int, float, double, blacspp::internal::scomplex, blacspp::internal::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Circular Shift", "[shift]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const int64_t M(3), N(2), LDA(5);
+  const auto npr = grid.npr();
+  const auto npc = grid.npc();
+
+  std::vector< TestType > data_send( LDA*N, TestType(mpi.rank()) );
+  std::vector< TestType > data_recv( LDA*N, TestType(-1) );
+
+  auto wrap = []( int64_t i, int64_t n ) { return (i % n + n) % n; };
+
+  // Rank of the process DISP positions behind along scope
+  auto source_rank = [&]( blacspp::Scope scope, int64_t disp ) {
+    if( scope == blacspp::Scope::Row )
+      return grid.comm_rank( grid.ipr(), wrap( grid.ipc() - disp, npc ) );
+    if( scope == blacspp::Scope::Column )
+      return grid.comm_rank( wrap( grid.ipr() - disp, npr ), grid.ipc() );
+    auto idx = wrap( grid.ipr()*npc + grid.ipc() - disp, npr*npc );
+    return grid.comm_rank( idx / npc, idx % npc );
+  };
+
+  auto check = [&]( const std::vector<TestType>& data, int64_t ld, TestType val ) {
+    for( int64_t j = 0; j < N;  ++j )
+    for( int64_t i = 0; i < ld; ++i ) {
+      if( i < M ) CHECK( data[i + j*ld] == val );
+      else        CHECK( data[i + j*ld] == TestType(-1) );
+    }
+  };
+
+  for( auto scope : { blacspp::Scope::Row, blacspp::Scope::Column, blacspp::Scope::All } )
+  for( int64_t disp : { 1, -1, 2, 0 } ) {
+
+    // Sendrecv
+    blacspp::shift( grid, scope, disp, M, N, data_send.data(), LDA, 
+                    data_recv.data(), LDA );
+    check( data_recv, LDA, TestType(source_rank( scope, disp )) );
+    for( auto x : data_send ) CHECK( x == TestType(mpi.rank()) );
+    std::fill( data_recv.begin(), data_recv.end(), TestType(-1) );
+
+    // Non-blocking
+    auto req = blacspp::ishift( grid, scope, disp, M, N, data_send.data(), LDA,
+                                data_recv.data(), LDA );
+    req.wait();
+    check( data_recv, LDA, TestType(source_rank( scope, disp )) );
+
+    // In-place
+    std::vector< TestType > data( LDA*N, TestType(-1) );
+    for( int64_t j = 0; j < N; ++j )
+    for( int64_t i = 0; i < M; ++i ) data[i + j*LDA] = TestType(mpi.rank());
+    blacspp::shift( grid, scope, disp, M, N, data.data(), LDA );
+    check( data, LDA, TestType(source_rank( scope, disp )) );
+
+    std::fill( data_recv.begin(), data_recv.end(), TestType(-1) );
+
+  }
+
+}
+
+
+TEST_CASE( "Double-Buffered Shift", "[shift]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  blacspp::ShiftBuffer<double> buf( 4, 3 );
+  std::fill_n( buf.data(), buf.m() * buf.n(), double(mpi.rank()) );
+
+  // Cannon-style: npc unit shifts along the row return the original data,
+  // and every row member is visited exactly once along the way
+  std::vector<int> seen( mpi.size(), 0 );
+  for( int64_t step = 0; step < grid.npc(); ++step ) {
+    buf.start( grid, blacspp::Scope::Row, 1 );
+    seen[ int(buf.data()[0]) ]++; // compute on current while in flight
+    buf.finish();
+  }
+
+  for( int64_t i = 0; i < buf.m() * buf.n(); ++i )
+    CHECK( buf.data()[i] == mpi.rank() );
+  for( int64_t pc = 0; pc < grid.npc(); ++pc )
+    CHECK( seen[ grid.comm_rank( grid.ipr(), pc ) ] == 1 );
+
+  buf.shift( grid, blacspp::Scope::Column, -1 );
+  CHECK( buf.data()[0] == 
+    grid.comm_rank( (grid.ipr() + 1) % grid.npr(), grid.ipc() ) );
+
+}
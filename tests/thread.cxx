@@ -0,0 +1,105 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/grid.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE( "Thread Views", "[thread]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  SECTION( "Single View" ) {
+
+    auto views = grid.thread_views(1);
+    REQUIRE( views.size() == 1 );
+
+    auto& view = views[0];
+    REQUIRE( view.is_valid() );
+    CHECK( view.npr() == grid.npr() );
+    CHECK( view.npc() == grid.npc() );
+    CHECK( view.ipr() == grid.ipr() );
+    CHECK( view.ipc() == grid.ipc() );
+    CHECK( view.comm()    != grid.comm()    );
+    CHECK( view.context() != grid.context() );
+
+  }
+
+  SECTION( "Concurrent Ring Stress" ) {
+
+    if( blacspp::mpi_thread_level() < MPI_THREAD_MULTIPLE ) {
+      WARN( "MPI_THREAD_MULTIPLE not provided, skipping" );
+      return;
+    }
+
+    const int64_t nthreads = 4;
+    const int64_t niter    = 200;
+    const int64_t nelem    = 64;
+
+    auto views = grid.thread_views( nthreads );
+    REQUIRE( views.size() == nthreads );
+
+    // Catch2 assertions are not thread safe, collect errors per thread
+    std::vector<int64_t> nerr( nthreads, 0 );
+
+    auto stream = [&]( int64_t tid ) {
+
+      const auto& view = views[tid];
+      const auto npc   = view.npc();
+      const auto ipr   = view.ipr();
+      const auto right = (view.ipc() + 1) % npc;
+      const auto left  = (view.ipc() + npc - 1) % npc;
+
+      std::vector<double> send( nelem ), recv( nelem );
+      auto expect = [&]( int64_t it, int64_t from ) {
+        for( int64_t i = 0; i < nelem; ++i )
+          if( recv[i] != double( ((tid * niter + it) * npc + from) * nelem + i ) ) nerr[tid]++;
+      };
+
+      for( int64_t it = 0; it < niter; ++it ) {
+
+        for( int64_t i = 0; i < nelem; ++i ) 
+          send[i] = ((tid * niter + it) * npc + view.ipc()) * nelem + i;
+
+        // Every thread uses the same tags: only the view separates them
+        auto rreq = blacspp::igerv2d( view, nelem, 1, recv.data(), nelem, ipr, left  );
+        auto sreq = blacspp::igesd2d( view, nelem, 1, send.data(), nelem, ipr, right );
+        rreq.wait(); sreq.wait();
+        expect( it, left );
+
+        // Row broadcast from a rotating root
+        const auto root = it % npc;
+        if( view.ipc() == root ) {
+          blacspp::igebs2d( view, blacspp::Scope::Row, nelem, 1, send.data(), nelem ).wait();
+        } else {
+          blacspp::igebr2d( view, blacspp::Scope::Row, nelem, 1, recv.data(), nelem, 
+                            ipr, root ).wait();
+          expect( it, root );
+        }
+
+        // Raw MPI on the view's communicator takes ranks from comm_rank
+        MPI_Sendrecv( send.data(), nelem, MPI_DOUBLE, view.comm_rank( ipr, right ), 0,
+                      recv.data(), nelem, MPI_DOUBLE, view.comm_rank( ipr, left  ), 0,
+                      view.comm(), MPI_STATUS_IGNORE );
+        expect( it, left );
+
+      }
+
+    };
+
+    std::vector<std::thread> threads;
+    for( int64_t tid = 0; tid < nthreads; ++tid )
+      threads.emplace_back( stream, tid );
+    for( auto& t : threads ) t.join();
+
+    for( auto e : nerr ) CHECK( e == 0 );
+
+  }
+
+}
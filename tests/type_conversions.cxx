@@ -0,0 +1,31 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/util/type_conversions.hpp>
+#include <limits>
+
+TEST_CASE( "BLACS Integer Conversion", "[type-conversions]" ) {
+
+  using blacspp::internal::blacs_int;
+  using blacspp::detail::to_blacs_int;
+
+  static_assert( to_blacs_int( 42 ) == 42, "to_blacs_int must be constexpr" );
+
+  const int64_t imax = std::numeric_limits<blacs_int>::max();
+  const int64_t imin = std::numeric_limits<blacs_int>::min();
+
+  CHECK( to_blacs_int(  0 ) ==  0 );
+  CHECK( to_blacs_int( -1 ) == -1 );
+  CHECK( to_blacs_int( imax ) == imax );
+  CHECK( to_blacs_int( imin ) == imin );
+
+  if( std::is_same< blacs_int, int32_t >::value ) {
+    CHECK_THROWS_AS( to_blacs_int( imax + 1 ), std::runtime_error );
+    CHECK_THROWS_AS( to_blacs_int( imin - 1 ), std::runtime_error );
+  }
+
+}
@@ -10,7 +10,8 @@
 
 int main(int argc, char* argv[])
 {
-    MPI_Init(&argc,&argv);
+    int provided;
+    MPI_Init_thread(&argc,&argv,MPI_THREAD_MULTIPLE,&provided);
 
     int mpi_rank;
     MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);